@@ -2,6 +2,8 @@
 
 #include "legendre_polys.hpp"
 #include "limiter.hpp"
+#include "parallel/parallel_for.hpp"
+#include "parallel/parallel_reduce.hpp"
 #include "period_index.hpp"
 #include "solver/solver_virtual.hpp"
 
@@ -23,13 +25,12 @@ public:
     double get_dt(const Vec &var, Mesh1d &ex, double t) const override {
         const auto &u = var.data;
 
-        double df_max = 0;
         size_t cell_num = u.size() / (m_DG_k + 1);
 
-        for (size_t i = 0; i < cell_num; i++) {
-            double tmp = std::abs(evals<P>(u, 0, i * (m_DG_k + 1), m_DG_k + 1));
-            if (tmp > df_max) df_max = tmp;
-        }
+        // df(u) = u at the cell means
+        double df_max = parallel_max(0, cell_num, [&](size_t i) {
+            return std::abs(evals<P>(u, 0, i * (m_DG_k + 1), m_DG_k + 1));
+        });
 
         auto coeff = static_cast<double>(2 * m_DG_k + 1);  // DG CFL
 
@@ -47,27 +48,27 @@ public:
         auto ul = std::vector<double>(cell_num);
         auto uc = std::vector<double>(cell_num);
         auto ur = std::vector<double>(cell_num);
-        for (size_t i = 0; i < cell_num; i++) {
+        parallel_for(0, cell_num, [&](size_t i) {
             ul[i] = evals<P>(u, -1, i * (m_DG_k + 1), m_DG_k + 1);
             uc[i] = evals<P>(u, 0, i * (m_DG_k + 1), m_DG_k + 1);
             ur[i] = evals<P>(u, 1, i * (m_DG_k + 1), m_DG_k + 1);
-        }
+        });
 
         auto fhat_l = std::vector<double>(cell_num);
         auto fhat_r = std::vector<double>(cell_num);
 
-        for (size_t i = 0; i < cell_num; i++) {
+        parallel_for(0, cell_num, [&](size_t i) {
             auto idx = PeriodIndex(cell_num, i);
 
             fhat_l[idx.c()] = fhat_LF(ur[idx.l()], ul[idx.c()]);
             fhat_r[idx.c()] = fhat_LF(ur[idx.c()], ul[idx.r()]);
-        }
+        });
 
         auto [gauss_points, gauss_weights] =
             gausslegendre(static_cast<unsigned>(m_gauss_k));
 
         auto L = std::vector<double>(u.size());
-        for (size_t i = 0; i < cell_num; i++) {
+        parallel_for(0, cell_num, [&](size_t i) {
             for (size_t j = 0; j <= m_DG_k; j++) {
                 double tmp_sum = 0;
                 for (size_t gauss_i = 0; gauss_i < m_gauss_k; gauss_i++) {
@@ -86,7 +87,7 @@ public:
 
                 L[i * (m_DG_k + 1) + j] = inner_inv * (Fu - br + bl);
             }
-        }
+        });
         return Vec{L};
     }
 
@@ -114,26 +115,30 @@ public:
         auto ul = std::vector<double>(cell_num);
         auto u_mean = std::vector<double>(cell_num);
         auto ur = std::vector<double>(cell_num);
-        for (size_t i = 0; i < cell_num; i++) {
+        parallel_for(0, cell_num, [&](size_t i) {
             ul[i] = evals<P>(u, -1, i * (m_DG_k + 1), m_DG_k + 1);
             u_mean[i] = u[i * (m_DG_k + 1)];
             ur[i] = evals<P>(u, 1, i * (m_DG_k + 1), m_DG_k + 1);
-        }
+        });
 
         auto limiter = Limiter{m_tvb_M * ex.dx * ex.dx};  // add limiter
 
         auto u2 = std::vector<double>(u);
-        for (size_t i = 0; i < cell_num; i++) {
-            auto idx = PeriodIndex(cell_num, i);
-
-            double ret_ul = ul[idx.c()];
-            double ret_ur = ur[idx.c()];
-            limiter.minmod(ret_ul, ret_ur, u_mean[idx.l()], u_mean[idx.c()],
-                           u_mean[idx.r()]);
-
-            Limiter::DG_recover(u2, i * (m_DG_k + 1), m_DG_k, u_mean[idx.c()],
-                                ret_ul, ret_ur);
-        }
+        // limited cells cost more, idle threads steal them
+        parallel_for(
+            0, cell_num,
+            [&](size_t i) {
+                auto idx = PeriodIndex(cell_num, i);
+
+                double ret_ul = ul[idx.c()];
+                double ret_ur = ur[idx.c()];
+                limiter.minmod(ret_ul, ret_ur, u_mean[idx.l()], u_mean[idx.c()],
+                               u_mean[idx.r()]);
+
+                Limiter::DG_recover(u2, i * (m_DG_k + 1), m_DG_k,
+                                    u_mean[idx.c()], ret_ul, ret_ur);
+            },
+            {.schedule = Schedule::Dynamic});
 
         return Vec{u2};
     }
@@ -147,22 +152,20 @@ int main() {
     auto cfg_p = plot_config();
     cfg_p.gauss_k = gauss_k;
 
-    // no limiter
+    auto solver1 = DGSolver{DG_k, gauss_k};                  // no limiter
+    auto solver2 = DGSolverWithLimiter{DG_k, gauss_k, 0};    // with limiter
+    auto solver3 = DGSolverWithLimiter{DG_k, gauss_k, 1.0};  // with limiter
+
+    auto study = ConvergenceStudy{cig_o.nlist};
+    study.add(OUTPUT_DIR "/order_1_v.csv", DG_order_case(cig_o, solver1, DG_k));
+    study.add(OUTPUT_DIR "/order_2_v.csv", DG_order_case(cig_o, solver2, DG_k));
+    study.add(OUTPUT_DIR "/order_3_v.csv", DG_order_case(cig_o, solver3, DG_k));
+    DG_order_test(study);
 
-    auto solver1 = DGSolver{DG_k, gauss_k};
-    DG_order_test(cig_o, solver1, DG_k, OUTPUT_DIR "/order_1_v.csv");
     DG_plot_test(cfg_p, solver1, DG_k,
                  {OUTPUT_DIR "/plot_11_v.csv", OUTPUT_DIR "/plot_12_v.csv"});
-
-    // with limiter
-
-    auto solver2 = DGSolverWithLimiter{DG_k, gauss_k, 0};
-    DG_order_test(cig_o, solver2, DG_k, OUTPUT_DIR "/order_2_v.csv");
     DG_plot_test(cfg_p, solver2, DG_k,
                  {OUTPUT_DIR "/plot_21_v.csv", OUTPUT_DIR "/plot_22_v.csv"});
-
-    auto solver3 = DGSolverWithLimiter{DG_k, gauss_k, 1.0};
-    DG_order_test(cig_o, solver3, DG_k, OUTPUT_DIR "/order_3_v.csv");
     DG_plot_test(cfg_p, solver3, DG_k,
                  {OUTPUT_DIR "/plot_31_v.csv", OUTPUT_DIR "/plot_32_v.csv"});
 
@@ -2,6 +2,7 @@
 #include "legendre_polys.hpp"
 #include "linespace.hpp"
 
+#include "convergence_study.hpp"
 #include "error_and_order.hpp"
 #include "export_to_file.hpp"
 
@@ -100,45 +101,37 @@ void DG_plot_test(Config cfg, SolverType solver, size_t DG_k,
     }
 }
 
+// one scheme of the order test, see ConvergenceStudy
 template <typename SolverType>
-void DG_order_test(Config cfg, SolverType solver, size_t DG_k,
-                   const char *filename) {
-    double dx = 0;
-    size_t gauss_k = cfg.gauss_k;
-
-    auto [gauss_points, _] = gausslegendre(static_cast<unsigned>(gauss_k));
-
-    auto &nlist = cfg.nlist;
-
-    auto error_l1 = std::vector<double>(nlist.size());
-    auto error_l2 = std::vector<double>(nlist.size());
-    auto error_linf = std::vector<double>(nlist.size());
-
-    for (size_t i = 0; i < nlist.size(); i++) {
-        size_t n = nlist[i];
+auto DG_order_case(Config cfg, SolverType solver, size_t DG_k) {
+    return [=](size_t n) {
+        double dx = 0;
+        size_t gauss_k = cfg.gauss_k;
         auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
 
         // L2 Projection
         auto uh = DG_projection(cfg.init, x, dx, DG_k, gauss_k);
 
+        // the cases run concurrently, each on its own solver
         auto ex = Mesh1d{dx};
-        uh = solver.run(Vec{uh}, ex, 0, cfg.tend).value().data;
+        auto local_solver = solver;
+        uh = local_solver.run(Vec{uh}, ex, 0, cfg.tend).value().data;
 
         auto errs = DG_error(
             uh, [cfg](double s) { return cfg.exact(s, cfg.tend); }, x, dx, DG_k,
             gauss_k);
 
-        error_l1[i] = std::get<0>(errs);
-        error_l2[i] = std::get<1>(errs);
-        error_linf[i] = std::get<2>(errs);
-    }
-
-    auto order_l1 = order(error_l1, nlist);
-    auto order_l2 = order(error_l2, nlist);
-    auto order_linf = order(error_linf, nlist);
+        return ErrorNorms{.l1 = std::get<0>(errs),
+                          .l2 = std::get<1>(errs),
+                          .linf = std::get<2>(errs)};
+    };
+}
 
-    print_error_table(std::cout, nlist, error_l1, error_l2, error_linf,
-                      order_l1, order_l2, order_linf, ' ');
-    print_error_table_to_file(filename, nlist, error_l1, error_l2, error_linf,
-                              order_l1, order_l2, order_linf, '&');
+// runs the order tests of all schemes concurrently, the name of a scheme is
+// the file its error table is written to
+inline void DG_order_test(const ConvergenceStudy &study) {
+    for (const auto &table : study.run()) {
+        table.print(std::cout, ' ');
+        table.print_to_file(table.name, '&');
+    }
 }
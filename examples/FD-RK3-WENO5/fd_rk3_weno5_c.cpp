@@ -1,5 +1,5 @@
 #include "fd_test.hpp"
-#include "period_index.hpp"
+#include "parallel/parallel_reduce.hpp"
 #include "solver/solver_crtp.hpp"
 #include "weno5.hpp"
 
@@ -9,11 +9,10 @@ using flux::solver_crtp::RK3Solver;
 class FDWENO5Solver : public RK3Solver<Vec, Mesh1d, FDWENO5Solver> {
 public:
     static double get_dt(const Vec &var, Mesh1d &ex, double t) {
-        double df_max = 0;
-        for (const auto ui : var.data) {
-            double tmp = std::abs(ui);  // df(u) = u
-            if (tmp > df_max) df_max = tmp;
-        }
+        const auto &u = var.data;
+        // df(u) = u
+        double df_max =
+            parallel_max(0, u.size(), [&](size_t i) { return std::abs(u[i]); });
         return std::pow(ex.dx, 5.0 / 3) / (2 * df_max);
     }
 
@@ -22,37 +21,12 @@ public:
         size_t n = u.size();
         auto L = std::vector<double>(n);
 
-        double lf_c{0};  // gobal c
-        for (size_t i = 0; i < n; i++) {
-            double lf_c_tmp = std::abs(u[i]);
-            lf_c = (lf_c_tmp > lf_c) ? lf_c_tmp : lf_c;
-        }
-
-        // split
-        auto fplus = [lf_c](double v) { return 0.5 * (v * v / 2 + lf_c * v); };
-        auto fminus = [lf_c](double v) { return 0.5 * (v * v / 2 - lf_c * v); };
-        auto fu_plus = std::vector<double>(n);
-        auto fu_minus = std::vector<double>(n);
-
-        for (size_t i = 0; i < n; i++) {
-            fu_plus[i] = fplus(u[i]);
-            fu_minus[i] = fminus(u[i]);
-        }
-
-        auto fplus_r = std::vector<double>(n);
-        auto fplus_l_useless = std::vector<double>(n);   // useless
-        auto fminus_r_useless = std::vector<double>(n);  // useless
-        auto fminus_l = std::vector<double>(n);
-
-        weno5(fu_plus, fplus_l_useless, fplus_r);
-        weno5(fu_minus, fminus_l, fminus_r_useless);
+        // global c, max is exact in any order
+        double lf_c =
+            parallel_max(0, n, [&](size_t i) { return std::abs(u[i]); });
 
-        for (size_t i = 0; i < n; i++) {
-            auto idx = PeriodIndex(n, i);
-            double fhat_l = fplus_r[idx.l()] + fminus_l[idx.c()];
-            double fhat_r = fplus_r[idx.c()] + fminus_l[idx.r()];
-            L[i] = (fhat_l - fhat_r) / ex.dx;
-        }
+        // split, WENO of f+ and f-, flux difference
+        weno5_fd_lf(u, lf_c, [](auto v) { return v * v / 2; }, ex.dx, L);
         return Vec{L};
     }
 };
@@ -0,0 +1,124 @@
+#include "fd_test.hpp"
+#include "parallel/parallel_reduce.hpp"
+#include "solver/solver_crtp.hpp"
+#include "weno.hpp"
+#include "weno5.hpp"
+
+#include <array>
+#include <chrono>
+#include <iostream>
+
+using namespace flux;  // NOLINT
+using flux::solver_crtp::RK3Solver;
+
+// fd_rk3_weno5_c with the reconstruction of the given order. As for WENO5
+// the time step scales as dx^(Order / 3), so the error of RK3, dt^3, stays
+// below the one of the reconstruction, dx^Order.
+template <size_t Order>
+class FDWenoSolver : public RK3Solver<Vec, Mesh1d, FDWenoSolver<Order>> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        const auto &u = var.data;
+        // df(u) = u
+        double df_max =
+            parallel_max(0, u.size(), [&](size_t i) { return std::abs(u[i]); });
+        return std::pow(ex.dx, static_cast<double>(Order) / 3) / (2 * df_max);
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        const auto &u = var.data;
+        size_t n = u.size();
+        auto L = std::vector<double>(n);
+
+        // global c, max is exact in any order
+        double lf_c =
+            parallel_max(0, n, [&](size_t i) { return std::abs(u[i]); });
+
+        // split, WENO of f+ and f-, flux difference
+        weno_fd_lf<Order>(u, lf_c, [](auto v) { return v * v / 2; }, ex.dx,
+                          L);
+        return Vec{L};
+    }
+};
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// seconds per evaluation of op(u, L) on 2^20 points
+template <typename OperatorType>
+double operator_time(const OperatorType &op) {
+    size_t n = size_t{1} << 20;
+    auto u = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+        double x = static_cast<double>(i) / static_cast<double>(n);
+        u[i] = std::sin(2 * pi * x);
+    }
+    auto L = std::vector<double>(n);
+
+    op(u, L);  // warm up
+    size_t repeat = 20;
+    auto start = Clock::now();
+    for (size_t k = 0; k < repeat; k++) { op(u, L); }
+    return seconds_since(start) / static_cast<double>(repeat);
+}
+
+// L1 error and run time of the order test case, n points
+template <size_t Order>
+void accuracy(size_t n) {
+    auto cfg = order_test_config();
+    double dx = 0;
+    auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
+    auto uh = std::vector<double>(n);
+    auto u = std::vector<double>(n);
+    for (size_t j = 0; j < n; j++) {
+        uh[j] = cfg.init(x[j]);
+        u[j] = cfg.exact(x[j], cfg.tend);
+    }
+
+    auto ex = Mesh1d{dx};
+    auto start = Clock::now();
+    uh = FDWenoSolver<Order>{}.run(Vec{uh}, ex, 0, cfg.tend).value().data;
+    double seconds = seconds_since(start);
+    std::cout << "WENO" << Order << ", " << n
+              << " points: L1 error = " << error(uh, u, dx, ErrorType::L1)
+              << ", " << seconds << " s\n";
+}
+}  // namespace
+
+int main() {
+    // weno_fd_lf<5> only differs from weno5_fd_lf by rounding
+    auto f = [](auto v) { return v * v / 2; };
+    auto names = std::array{"weno5_fd_lf", "weno_fd_lf<5>", "weno_fd_lf<7>",
+                            "weno_fd_lf<9>"};
+    auto seconds = std::array{
+        operator_time([&](const auto &u, auto &L) {
+            weno5_fd_lf(u, 1.0, f, 0.1, L);
+        }),
+        operator_time([&](const auto &u, auto &L) {
+            weno_fd_lf<5>(u, 1.0, f, 0.1, L);
+        }),
+        operator_time([&](const auto &u, auto &L) {
+            weno_fd_lf<7>(u, 1.0, f, 0.1, L);
+        }),
+        operator_time([&](const auto &u, auto &L) {
+            weno_fd_lf<9>(u, 1.0, f, 0.1, L);
+        }),
+    };
+    std::cout << "operator on 2^20 points\n";
+    for (size_t k = 0; k < names.size(); k++) {
+        std::cout << names[k] << ": " << seconds[k] << " s, "
+                  << seconds[k] / seconds[0] << " x weno5_fd_lf\n";
+    }
+
+    // the same error with fewer points
+    std::cout << "\nBurgers' equation, smooth solution\n";
+    for (size_t n : std::vector<size_t>{40, 80, 160}) { accuracy<5>(n); }
+    for (size_t n : std::vector<size_t>{20, 40, 80}) { accuracy<7>(n); }
+    for (size_t n : std::vector<size_t>{20, 40, 80}) { accuracy<9>(n); }
+
+    return 0;
+}
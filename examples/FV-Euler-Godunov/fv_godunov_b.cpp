@@ -0,0 +1,135 @@
+#include "batch.hpp"
+#include "config.hpp"
+#include "linespace.hpp"
+#include "parallel/parallel_reduce.hpp"
+#include "period_index.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+
+#include <chrono>
+#include <iostream>
+
+using namespace flux;  // NOLINT
+using flux::solver_crtp::EulerSolver;
+
+namespace {
+// same values as fhat_godunov, without branches so that the batch loop
+// vectorizes (f(u) = u^2 / 2 is convex with its minimum at 0)
+constexpr auto fhat_godunov_branchless = [](double ul, double ur) {
+    double l = std::max(ul, 0.0);
+    double r = std::min(ur, 0.0);
+    return std::max(l * l / 2, r * r / 2);
+};
+
+double fhat_godunov(double ul, double ur) {
+    if (ul <= ur) {  // min
+        if (ul * ur > 0) { return std::min(ul * ul / 2, ur * ur / 2); }
+        return 0.0;
+    }
+    return std::max(ul * ul / 2, ur * ur / 2);  // max
+}
+
+double df(double u) { return u; }  // df(u) = u
+}  // namespace
+
+// one problem at a time, as fv_godunov_c
+class FVGodunovSolver : public EulerSolver<Vec, Mesh1d, FVGodunovSolver> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        const auto &u = var.data;
+        double df_max = parallel_max(
+            0, u.size(), [&](size_t i) { return std::abs(df(u[i])); });
+        return 0.5 * ex.dx / df_max;
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        const auto &u = var.data;
+        size_t n = u.size();
+        auto L = std::vector<double>(n);
+        for (size_t i = 0; i < n; i++) {
+            auto idx = PeriodIndex(n, i);
+            double fhat_l = fhat_godunov(u[idx.l()], u[idx.c()]);
+            double fhat_r = fhat_godunov(u[idx.c()], u[idx.r()]);
+            L[i] = (fhat_l - fhat_r) / ex.dx;
+        }
+        return Vec{L};
+    }
+};
+
+// all problems at once, interleaved
+class FVGodunovBatchSolver
+    : public EulerSolver<Vec, BatchMesh, FVGodunovBatchSolver> {
+public:
+    static double get_dt(const Vec &var, BatchMesh &ex, double t) {
+        auto dt = batch_cfl_dt(var, ex, 0.5, [](double u) { return df(u); });
+        return batch_step_dt(dt, ex, t);
+    }
+
+    static Vec op_L(const Vec &var, BatchMesh &ex, double t) {
+        return batch_flux_difference(var, ex, fhat_godunov_branchless);
+    }
+};
+
+int main() {
+    size_t n = 640;
+    size_t batch = 64;
+    double tend = 0.5;
+
+    // u0(x) = a + sin(x + phi) with different a and phi
+    double dx = 0;
+    auto x = linespace_mid(-pi, pi, n, dx);
+    auto problems = std::vector<std::vector<double>>(batch);
+    auto exact = std::vector<BurgersExact>{};
+    for (size_t b = 0; b < batch; b++) {
+        double a = 0.5 + 0.25 * sin(static_cast<double>(b));
+        double phi = 2 * pi * static_cast<double>(b) / 64;
+        exact.emplace_back(a, 1.0, 1.0, phi, 1e-10);
+        problems[b] = std::vector<double>(n);
+        for (size_t i = 0; i < n; i++) {
+            problems[b][i] = exact[b].init_value(x[i]);
+        }
+    }
+
+    // maximum of the Linf errors of all problems
+    auto max_error = [&](const std::vector<std::vector<double>> &result) {
+        double e = 0;
+        for (size_t b = 0; b < batch; b++) {
+            for (size_t i = 0; i < n; i++) {
+                double u = exact[b].eval(x[i], tend);
+                e = std::max(e, std::abs(result[b][i] - u));
+            }
+        }
+        return e;
+    };
+
+    using Clock = std::chrono::steady_clock;
+    auto seconds_since = [](Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    auto start = Clock::now();
+    auto result = std::vector<std::vector<double>>(batch);
+    for (size_t b = 0; b < batch; b++) {
+        auto ex = Mesh1d{dx};
+        result[b] =
+            FVGodunovSolver{}.run(Vec{problems[b]}, ex, 0, tend).value().data;
+    }
+    std::cout << "one at a time: " << seconds_since(start)
+              << " s, error_inf = " << max_error(result) << '\n';
+
+    for (auto mode : {BatchDt::Shared, BatchDt::Masked}) {
+        start = Clock::now();
+        auto ex = BatchMesh{
+            .dx = dx, .batch = batch, .dt_mode = mode, .tend = tend};
+        auto var = FVGodunovBatchSolver{}
+                       .run(batch_pack(problems), ex, 0, tend)
+                       .value();
+        result = batch_unpack(var, batch);
+        std::cout << (mode == BatchDt::Shared ? "batch, shared dt: "
+                                              : "batch, masked dt: ")
+                  << seconds_since(start)
+                  << " s, error_inf = " << max_error(result) << '\n';
+    }
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+#include "config.hpp"
+#include "linespace.hpp"
+#include "parallel/domain.hpp"
+#include "parallel/parallel_reduce.hpp"
+#include "period_index.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+
+#include "gaussquadrature/gausslegendre.hpp"
+#include "gaussquadrature/quadrature.hpp"
+
+#include <iostream>
+
+using namespace flux;  // NOLINT
+using flux::solver_crtp::EulerInplaceSolver;
+
+namespace {
+double fhat_godunov(double ul, double ur) {
+    if (ul <= ur) {  // min
+        if (ul * ur > 0) { return std::min(ul * ul / 2, ur * ur / 2); }
+        return 0.0;
+    }
+    return std::max(ul * ul / 2, ur * ur / 2);  // max
+}
+}  // namespace
+
+// the global operator with PeriodIndex, as fv_godunov_c
+class FVGodunovSolver
+    : public EulerInplaceSolver<Vec, Mesh1d, FVGodunovSolver> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        const auto &u = var.data;
+        // df(u) = u
+        double df_max =
+            parallel_max(0, u.size(), [&](size_t i) { return std::abs(u[i]); });
+        return 0.5 * ex.dx / df_max;
+    }
+
+    static void op_L(const Vec &var, Vec &out, Mesh1d &ex, double t) {
+        const auto &u = var.data;
+        size_t n = u.size();
+        for (size_t i = 0; i < n; i++) {
+            auto idx = PeriodIndex(n, i);
+            double fhat_l = fhat_godunov(u[idx.l()], u[idx.c()]);
+            double fhat_r = fhat_godunov(u[idx.c()], u[idx.r()]);
+            out[i] = (fhat_l - fhat_r) / ex.dx;
+        }
+    }
+};
+
+// one local operator per subdomain, the ghosts replace PeriodIndex
+class FVGodunovDomainSolver
+    : public EulerInplaceSolver<Vec, Mesh1d, FVGodunovDomainSolver> {
+public:
+    explicit FVGodunovDomainSolver(const Decomposition &domain)
+        : m_domain(domain) {}
+
+    // global reduction over the subdomains (and ranks)
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        double df_max = m_domain.max_over_parts([&](const Part &p) {
+            auto u = m_domain.local(var.data, p);
+            double result = 0;
+            for (size_t i = 1; i <= p.cells; i++) {
+                double tmp = std::abs(u[i]);  // df(u) = u
+                if (tmp > result) result = tmp;
+            }
+            return result;
+        });
+        return 0.5 * ex.dx / df_max;
+    }
+
+    void op_L(const Vec &var, Vec &out, Mesh1d &ex, double t) const {
+        m_domain.for_each_part([&](const Part &p) {
+            auto u = m_domain.local(var.data, p);  // halo 1, u[0] is a ghost
+            auto L = m_domain.local(out.data, p);
+            for (size_t i = 1; i <= p.cells; i++) {
+                double fhat_l = fhat_godunov(u[i - 1], u[i]);
+                double fhat_r = fhat_godunov(u[i], u[i + 1]);
+                L[i] = (fhat_l - fhat_r) / ex.dx;
+            }
+        });
+    }
+
+    // halo exchange before the stage reads the ghosts
+    void pre_process(Vec &var, Mesh1d &ex, double t) const {
+        m_domain.exchange(var.data);
+    }
+
+private:
+    const Decomposition &m_domain;
+};
+
+int main(int argc, char **argv) {
+#ifdef FLUX_MPI
+    MPI_Init(&argc, &argv);
+    // e.g. mpiexec -n 2 example_fv_godunov_d, 4 subdomains per rank
+    auto domain = Decomposition{640, 4, 1, MPI_COMM_WORLD};
+#else
+    auto domain = Decomposition{640, 8, 1};
+#endif
+
+    auto cfg = order_test_config();
+    double dx = 0;
+    auto x = linespace_mid(cfg.xl, cfg.xr, domain.cells(), dx);
+    auto g = Quadrature(gausslegendre(static_cast<unsigned>(cfg.gauss_k)));
+    auto exact = [=](double s) { return cfg.exact(s, cfg.tend); };
+
+    auto u0 = std::vector<double>(x.size());
+    auto u = std::vector<double>(x.size());
+    for (size_t j = 0; j < x.size(); j++) {
+        u0[j] = g.intg(cfg.init, {x[j] - dx / 2, x[j] + dx / 2}) / dx;
+        u[j] = g.intg(exact, {x[j] - dx / 2, x[j] + dx / 2}) / dx;
+    }
+
+    auto ex = Mesh1d{dx};
+    auto ref = FVGodunovSolver{}.run(Vec{u0}, ex, 0, cfg.tend).value().data;
+
+    auto var = Vec{domain.scatter(u0)};
+    var = FVGodunovDomainSolver{domain}.run(var, ex, 0, cfg.tend).value();
+    auto uh = domain.gather(var.data);
+
+    double diff = 0;
+    double error_inf = 0;
+    for (size_t j = 0; j < x.size(); j++) {
+        diff = std::max(diff, std::abs(uh[j] - ref[j]));
+        error_inf = std::max(error_inf, std::abs(uh[j] - u[j]));
+    }
+    if (domain.rank() == 0) {
+        std::cout << domain.ranks() * domain.parts()
+                  << " subdomains: error_inf = " << error_inf
+                  << ", difference to the global operator = " << diff << '\n';
+    }
+
+#ifdef FLUX_MPI
+    MPI_Finalize();
+#endif
+    return 0;
+}
@@ -1,4 +1,6 @@
 #include "fv_test.hpp"
+#include "parallel/parallel_for.hpp"
+#include "parallel/parallel_reduce.hpp"
 #include "period_index.hpp"
 #include "solver/solver_stdfunc.hpp"
 
@@ -11,11 +13,9 @@ auto FV_godunov_solver() {
 
     auto get_dt = [](const Vec &var, Mesh1d &ex, double t) {
         const auto &u = var.data;
-        double df_max = 0;
-        for (const auto ui : u) {
-            double tmp = std::abs(ui);  // df(u) = u
-            if (tmp > df_max) df_max = tmp;
-        }
+        // df(u) = u
+        double df_max =
+            parallel_max(0, u.size(), [&](size_t i) { return std::abs(u[i]); });
         return 0.5 * ex.dx / df_max;
     };
 
@@ -31,12 +31,12 @@ auto FV_godunov_solver() {
         const auto &u = var.data;
         size_t n = u.size();
         auto L = std::vector<double>(n);
-        for (size_t i = 0; i < n; i++) {
+        parallel_for(0, n, [&](size_t i) {
             auto idx = PeriodIndex(n, i);
             double fhat_l = fhat_godunov(u[idx.l()], u[idx.c()]);
             double fhat_r = fhat_godunov(u[idx.c()], u[idx.r()]);
             L[i] = (fhat_l - fhat_r) / ex.dx;
-        }
+        });
         return Vec{L};
     };
 
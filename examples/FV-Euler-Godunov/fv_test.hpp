@@ -1,6 +1,7 @@
 #include "config.hpp"
 #include "linespace.hpp"
 
+#include "convergence_study.hpp"
 #include "error_and_order.hpp"
 #include "export_to_file.hpp"
 
@@ -46,19 +47,14 @@ void FV_plot_test(Config cfg, SolverType solver,
 
 template <typename SolverType>
 void FV_order_test(Config cfg, SolverType solver, const char *filename) {
-    double dx = 0;
-
-    auto exact = [=](double x) { return cfg.exact(x, cfg.tend); };
+    auto order_case = [=](size_t n) {
+        double dx = 0;
 
-    // auto g = Quadrature::get_instance(cfg.gauss_k);
-    auto g = Quadrature(gausslegendre(static_cast<unsigned>(cfg.gauss_k)));
+        auto exact = [=](double x) { return cfg.exact(x, cfg.tend); };
 
-    auto error_l1 = std::vector<double>(cfg.nlist.size());
-    auto error_l2 = std::vector<double>(cfg.nlist.size());
-    auto error_linf = std::vector<double>(cfg.nlist.size());
+        // auto g = Quadrature::get_instance(cfg.gauss_k);
+        auto g = Quadrature(gausslegendre(static_cast<unsigned>(cfg.gauss_k)));
 
-    for (size_t i = 0; i < cfg.nlist.size(); i++) {
-        size_t n = cfg.nlist[i];
         auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
         auto uh = std::vector<double>(n);
 
@@ -67,8 +63,10 @@ void FV_order_test(Config cfg, SolverType solver, const char *filename) {
             uh[j] = tmp / dx;
         }
 
+        // the resolutions run concurrently, each on its own solver
         auto ex = Mesh1d{dx};
-        uh = solver.run(Vec{uh}, ex, 0, cfg.tend).value().data;
+        auto local_solver = solver;
+        uh = local_solver.run(Vec{uh}, ex, 0, cfg.tend).value().data;
 
         auto u = std::vector<double>(n);
         for (size_t j = 0; j < n; j++) {
@@ -76,17 +74,12 @@ void FV_order_test(Config cfg, SolverType solver, const char *filename) {
             u[j] = tmp / dx;
         }
 
-        error_l1[i] = error(uh, u, dx, ErrorType::L1);
-        error_l2[i] = error(uh, u, dx, ErrorType::L2);
-        error_linf[i] = error(uh, u, dx, ErrorType::Linf);
-    }
-
-    auto order_l1 = order(error_l1, cfg.nlist);
-    auto order_l2 = order(error_l2, cfg.nlist);
-    auto order_linf = order(error_linf, cfg.nlist);
+        return error_norms(uh, u, dx);
+    };
 
-    print_error_table(std::cout, cfg.nlist, error_l1, error_l2, error_linf,
-                      order_l1, order_l2, order_linf, ' ');
-    print_error_table_to_file(filename, cfg.nlist, error_l1, error_l2,
-                              error_linf, order_l1, order_l2, order_linf, '&');
+    auto study = ConvergenceStudy{cfg.nlist};
+    study.add(filename, order_case);
+    auto table = study.run().front();
+    table.print(std::cout, ' ');
+    table.print_to_file(filename, '&');
 }
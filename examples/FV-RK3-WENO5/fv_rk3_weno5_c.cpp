@@ -1,4 +1,6 @@
 #include "fv_test.hpp"
+#include "parallel/parallel_for.hpp"
+#include "parallel/parallel_reduce.hpp"
 #include "period_index.hpp"
 #include "solver/solver_crtp.hpp"
 #include "weno5.hpp"
@@ -9,11 +11,10 @@ using flux::solver_crtp::RK3Solver;  // NOLINT
 class FVWENO5Solver : public RK3Solver<Vec, Mesh1d, FVWENO5Solver> {
 public:
     static double get_dt(const Vec &var, Mesh1d &ex, double t) {
-        double df_max = 0;
-        for (const auto ui : var.data) {
-            double tmp = std::abs(ui);  // df(u) = u
-            if (tmp > df_max) df_max = tmp;
-        }
+        const auto &u = var.data;
+        // df(u) = u
+        double df_max =
+            parallel_max(0, u.size(), [&](size_t i) { return std::abs(u[i]); });
         return std::pow(ex.dx, 5.0 / 3) / (2 * df_max);
     }
 
@@ -26,12 +27,12 @@ public:
 
         weno5(u, ul_p, ur_m);  // WENO
 
-        for (size_t i = 0; i < n; i++) {
+        parallel_for(0, n, [&](size_t i) {
             auto idx = PeriodIndex(n, i);
             double fhat_l = fhat_LF(ur_m[idx.l()], ul_p[idx.c()]);
             double fhat_r = fhat_LF(ur_m[idx.c()], ul_p[idx.r()]);
             L[i] = (fhat_l - fhat_r) / ex.dx;
-        }
+        });
         return Vec{L};
     }
 
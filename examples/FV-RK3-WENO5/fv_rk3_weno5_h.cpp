@@ -0,0 +1,134 @@
+#include "fv_test.hpp"
+#include "parallel/parallel_for.hpp"
+#include "parallel/parallel_reduce.hpp"
+#include "period_index.hpp"
+#include "solver/solver_crtp.hpp"
+#include "weno.hpp"
+#include "weno5.hpp"
+
+#include <array>
+#include <chrono>
+#include <iostream>
+
+using namespace flux;                // NOLINT
+using flux::solver_crtp::RK3Solver;  // NOLINT
+
+namespace {
+double fhat_LF(double ul, double ur) {
+    double c = std::max(std::abs(ul), std::abs(ur));
+
+    double tmp1 = 0.5 * (ul * ul / 2 + ur * ur / 2);
+    double tmp2 = 0.5 * c * (ur - ul);
+    return tmp1 - tmp2;
+}
+}  // namespace
+
+// fv_rk3_weno5_c with the reconstruction of the given order. As for WENO5
+// the time step scales as dx^(Order / 3), so the error of RK3, dt^3, stays
+// below the one of the reconstruction, dx^Order.
+template <size_t Order>
+class FVWenoSolver : public RK3Solver<Vec, Mesh1d, FVWenoSolver<Order>> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        const auto &u = var.data;
+        // df(u) = u
+        double df_max =
+            parallel_max(0, u.size(), [&](size_t i) { return std::abs(u[i]); });
+        return std::pow(ex.dx, static_cast<double>(Order) / 3) / (2 * df_max);
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        const auto &u = var.data;
+        size_t n = u.size();
+        auto L = std::vector<double>(n);
+        auto ul_p = std::vector<double>(n);
+        auto ur_m = std::vector<double>(n);
+
+        weno<Order>(u, ul_p, ur_m);  // WENO
+
+        parallel_for(0, n, [&](size_t i) {
+            auto idx = PeriodIndex(n, i);
+            double fhat_l = fhat_LF(ur_m[idx.l()], ul_p[idx.c()]);
+            double fhat_r = fhat_LF(ur_m[idx.c()], ul_p[idx.r()]);
+            L[i] = (fhat_l - fhat_r) / ex.dx;
+        });
+        return Vec{L};
+    }
+};
+
+namespace {
+using Clock = std::chrono::steady_clock;
+
+double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+// seconds per reconstruction of 2^20 cells
+using WenoFunction = void (*)(const std::vector<double> &,
+                              std::vector<double> &, std::vector<double> &);
+
+double reconstruction_time(WenoFunction weno_n) {
+    size_t n = size_t{1} << 20;
+    auto u = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+        double x = static_cast<double>(i) / static_cast<double>(n);
+        u[i] = std::sin(2 * pi * x);
+    }
+    auto ul = std::vector<double>(n);
+    auto ur = std::vector<double>(n);
+
+    weno_n(u, ul, ur);  // warm up
+    size_t repeat = 20;
+    auto start = Clock::now();
+    for (size_t k = 0; k < repeat; k++) { weno_n(u, ul, ur); }
+    return seconds_since(start) / static_cast<double>(repeat);
+}
+
+// L1 error and run time of the order test case, n cells
+template <size_t Order>
+void accuracy(size_t n) {
+    auto cfg = order_test_config();
+    auto g = Quadrature(gausslegendre(static_cast<unsigned>(cfg.gauss_k)));
+    double dx = 0;
+    auto x = linespace_mid(cfg.xl, cfg.xr, n, dx);
+    auto uh = std::vector<double>(n);
+    auto u = std::vector<double>(n);
+    for (size_t j = 0; j < n; j++) {
+        uh[j] = g.intg(cfg.init, {x[j] - dx / 2, x[j] + dx / 2}) / dx;
+        u[j] = g.intg([&](double y) { return cfg.exact(y, cfg.tend); },
+                      {x[j] - dx / 2, x[j] + dx / 2})
+               / dx;
+    }
+
+    auto ex = Mesh1d{dx};
+    auto start = Clock::now();
+    uh = FVWenoSolver<Order>{}.run(Vec{uh}, ex, 0, cfg.tend).value().data;
+    double seconds = seconds_since(start);
+    std::cout << "WENO" << Order << ", " << n
+              << " cells: L1 error = " << error(uh, u, dx, ErrorType::L1)
+              << ", " << seconds << " s\n";
+}
+}  // namespace
+
+int main() {
+    // weno<5> only differs from weno5 by rounding
+    auto names = std::array{"weno5", "weno<5>", "weno<7>", "weno<9>"};
+    auto functions =
+        std::array<WenoFunction, 4>{&weno5<>, &weno<5>, &weno<7>, &weno<9>};
+    std::cout << "reconstruction of 2^20 cells\n";
+    double base = 0;
+    for (size_t k = 0; k < names.size(); k++) {
+        double seconds = reconstruction_time(functions[k]);
+        base = k == 0 ? seconds : base;
+        std::cout << names[k] << ": " << seconds << " s, " << seconds / base
+                  << " x weno5\n";
+    }
+
+    // the same error with fewer cells
+    std::cout << "\nBurgers' equation, smooth solution\n";
+    for (size_t n : std::vector<size_t>{40, 80, 160}) { accuracy<5>(n); }
+    for (size_t n : std::vector<size_t>{20, 40, 80}) { accuracy<7>(n); }
+    for (size_t n : std::vector<size_t>{20, 40, 80}) { accuracy<9>(n); }
+
+    return 0;
+}
@@ -0,0 +1,136 @@
+#include "config.hpp"
+#include "linespace.hpp"
+#include "parallel/parallel_for.hpp"
+#include "parallel/parallel_reduce.hpp"
+#include "period_index.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_template.hpp"
+#include "weno5.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+using namespace flux;  // NOLINT
+using flux::solver_template::EulerUpdater;
+using flux::solver_template::OpNull;
+using flux::solver_template::PararealSolver;
+using flux::solver_template::RK3Updater;
+using flux::solver_template::Solver;
+
+namespace {
+double df_max(const Vec &var) {
+    const auto &u = var.data;
+    // df(u) = u
+    return parallel_max(0, u.size(), [&](size_t i) { return std::abs(u[i]); });
+}
+}  // namespace
+
+// coarse: first order Godunov with forward Euler, large steps
+struct GetDtCoarse {
+    double operator()(const Vec &var, Mesh1d &ex, double t) const {
+        return 0.9 * ex.dx / df_max(var);
+    }
+};
+
+struct OpGodunov {
+    Vec operator()(const Vec &var, Mesh1d &ex, double t) const {
+        const auto &u = var.data;
+        size_t n = u.size();
+        auto L = std::vector<double>(n);
+        parallel_for(0, n, [&](size_t i) {
+            auto idx = PeriodIndex(n, i);
+            double fhat_l = fhat_godunov(u[idx.l()], u[idx.c()]);
+            double fhat_r = fhat_godunov(u[idx.c()], u[idx.r()]);
+            L[i] = (fhat_l - fhat_r) / ex.dx;
+        });
+        return Vec{L};
+    }
+
+    static double fhat_godunov(double ul, double ur) {
+        if (ul <= ur) {  // min
+            if (ul * ur > 0) { return std::min(ul * ul / 2, ur * ur / 2); }
+            return 0.0;
+        }
+        return std::max(ul * ul / 2, ur * ur / 2);  // max
+    }
+};
+
+// fine: WENO5 with SSP-RK3 and the fifth order step size
+struct GetDtFine {
+    double operator()(const Vec &var, Mesh1d &ex, double t) const {
+        return std::pow(ex.dx, 5.0 / 3) / (2 * df_max(var));
+    }
+};
+
+struct OpWENO5 {
+    Vec operator()(const Vec &var, Mesh1d &ex, double t) const {
+        const auto &u = var.data;
+        size_t n = u.size();
+        auto L = std::vector<double>(n);
+        auto ul_p = std::vector<double>(n);
+        auto ur_m = std::vector<double>(n);
+
+        weno5(u, ul_p, ur_m);  // WENO
+
+        parallel_for(0, n, [&](size_t i) {
+            auto idx = PeriodIndex(n, i);
+            double fhat_l = fhat_LF(ur_m[idx.l()], ul_p[idx.c()]);
+            double fhat_r = fhat_LF(ur_m[idx.c()], ul_p[idx.r()]);
+            L[i] = (fhat_l - fhat_r) / ex.dx;
+        });
+        return Vec{L};
+    }
+
+    static double fhat_LF(double ul, double ur) {
+        double c = std::max(std::abs(ul), std::abs(ur));
+
+        double tmp1 = 0.5 * (ul * ul / 2 + ur * ur / 2);
+        double tmp2 = 0.5 * c * (ur - ul);
+        return tmp1 - tmp2;
+    }
+};
+
+int main() {
+    using N = OpNull<Vec, Mesh1d>;
+    using Coarse = Solver<
+        Vec, Mesh1d, EulerUpdater<Vec, Mesh1d, OpGodunov, GetDtCoarse, N, N>>;
+    using Fine = Solver<
+        Vec, Mesh1d, RK3Updater<Vec, Mesh1d, OpWENO5, GetDtFine, N, N, N>>;
+
+    // a small grid and a long time, the shock forms at t = 4
+    size_t n = 200;
+    double dx = 0;
+    auto x = linespace_mid(-pi, pi, n, dx);
+    auto u0 = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) { u0[i] = 0.5 + 0.25 * std::sin(x[i]); }
+    auto ex = Mesh1d{dx};
+    double tend = 3.0;
+
+    using Clock = std::chrono::steady_clock;
+    auto seconds_since = [](Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    auto start = Clock::now();
+    auto ref = Fine{}.run(Vec{u0}, ex, 0, tend).value();
+    std::cout << "fine: " << seconds_since(start) << " s\n";
+
+    // 16 slices, so up to 16 cores run the fine solver
+    auto solver = PararealSolver<Vec, Mesh1d, Coarse, Fine>{
+        Coarse{}, Fine{}, {.slices = 16, .tol = 1e-6}};
+    auto report = PararealReport{};
+    start = Clock::now();
+    auto res = solver.run(Vec{u0}, ex, 0, tend, &report).value();
+    std::cout << "parareal: " << seconds_since(start) << " s, "
+              << report.iterations << " iterations\n";
+
+    // the fine solution differs by the steps cut at the slice ends
+    double diff = 0;
+    for (size_t i = 0; i < n; i++) {
+        diff = std::max(diff, std::abs(res[i] - ref[i]));
+    }
+    std::cout << n << " cells, difference = " << diff << '\n';
+
+    return 0;
+}
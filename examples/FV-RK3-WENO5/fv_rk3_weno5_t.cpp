@@ -0,0 +1,137 @@
+#include "config.hpp"
+#include "linespace.hpp"
+#include "parallel/parallel_for.hpp"
+#include "parallel/parallel_reduce.hpp"
+#include "period_index.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+#include "weno5.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <span>
+
+using namespace flux;  // NOLINT
+using flux::solver_crtp::RK3InplaceSolver;
+using flux::solver_crtp::TiledRK3Solver;
+
+namespace {
+double fhat_LF(double ul, double ur) {
+    double c = std::max(std::abs(ul), std::abs(ur));
+
+    double tmp1 = 0.5 * (ul * ul / 2 + ur * ur / 2);
+    double tmp2 = 0.5 * c * (ur - ul);
+    return tmp1 - tmp2;
+}
+
+double weno5_dt(const Vec &var, Mesh1d &ex) {
+    const auto &u = var.data;
+    // df(u) = u
+    double df_max =
+        parallel_max(0, u.size(), [&](size_t i) { return std::abs(u[i]); });
+    return std::pow(ex.dx, 5.0 / 3) / (2 * df_max);
+}
+}  // namespace
+
+// every stage sweeps the whole state: WENO, then the fluxes, then the update
+class FVWENO5Solver : public RK3InplaceSolver<Vec, Mesh1d, FVWENO5Solver> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return weno5_dt(var, ex);
+    }
+
+    static void op_L(const Vec &var, Vec &out, Mesh1d &ex, double t) {
+        const auto &u = var.data;
+        size_t n = u.size();
+        auto ul_p = std::vector<double>(n);
+        auto ur_m = std::vector<double>(n);
+
+        weno5(u, ul_p, ur_m);  // WENO
+
+        parallel_for(0, n, [&](size_t i) {
+            auto idx = PeriodIndex(n, i);
+            double fhat_l = fhat_LF(ur_m[idx.l()], ul_p[idx.c()]);
+            double fhat_r = fhat_LF(ur_m[idx.c()], ul_p[idx.r()]);
+            out[i] = (fhat_l - fhat_r) / ex.dx;
+        });
+    }
+};
+
+// the same operator on a tile, u[j + 3] is the cell of out[j]
+class FVWENO5TiledSolver
+    : public TiledRK3Solver<Vec, Mesh1d, FVWENO5TiledSolver> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return weno5_dt(var, ex);
+    }
+
+    static void op_L_tile(std::span<const double> u, std::span<double> out,
+                          const Mesh1d &ex, double t) {
+        auto faces = [&](size_t c) {
+            return weno5_faces(u[c - 2], u[c - 1], u[c], u[c + 1], u[c + 2]);
+        };
+
+        // one pass, the faces of a cell are reused by the next cell
+        auto center = faces(3);
+        double fhat_l = fhat_LF(faces(2).ur, center.ul);
+        for (size_t j = 0; j < out.size(); j++) {
+            auto right = faces(j + 4);
+            double fhat_r = fhat_LF(center.ur, right.ul);
+            out[j] = (fhat_l - fhat_r) / ex.dx;
+            fhat_l = fhat_r;
+            center = right;
+        }
+    }
+
+    explicit FVWENO5TiledSolver(TileSchedule schedule) : m_schedule(schedule) {}
+
+    TileOptions tile_options() const {
+        return {.radius = 3, .cells = 4096, .schedule = m_schedule};
+    }
+
+private:
+    TileSchedule m_schedule;
+};
+
+int main() {
+    size_t n = size_t{1} << 20;
+    double dx = 0;
+    auto x = linespace_mid(-pi, pi, n, dx);
+    auto u0 = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) { u0[i] = 0.5 + std::sin(x[i]); }
+
+    // about ten steps
+    auto ex = Mesh1d{dx};
+    double tend = 10 * weno5_dt(Vec{u0}, ex);
+
+    using Clock = std::chrono::steady_clock;
+    auto seconds_since = [](Clock::time_point start) {
+        return std::chrono::duration<double>(Clock::now() - start).count();
+    };
+
+    auto start = Clock::now();
+    auto ref = FVWENO5Solver{}.run(Vec{u0}, ex, 0, tend).value();
+    std::cout << "stage by stage: " << seconds_since(start) << " s\n";
+
+    start = Clock::now();
+    auto tiled = FVWENO5TiledSolver{TileSchedule::Temporal}
+                     .run(Vec{u0}, ex, 0, tend)
+                     .value();
+    std::cout << "tiled: " << seconds_since(start) << " s\n";
+
+    start = Clock::now();
+    auto graph = FVWENO5TiledSolver{TileSchedule::TaskGraph}
+                     .run(Vec{u0}, ex, 0, tend)
+                     .value();
+    std::cout << "task graph: " << seconds_since(start) << " s\n";
+
+    double diff = 0;
+    for (size_t i = 0; i < n; i++) {
+        diff = std::max({diff, std::abs(tiled[i] - ref[i]),
+                         std::abs(graph[i] - ref[i])});
+    }
+    std::cout << n << " cells, difference = " << diff << '\n';
+
+    return 0;
+}
@@ -0,0 +1,147 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "parallel/parallel_for.hpp"
+#include "period_index.hpp"
+#include "solver/preset.hpp"
+
+namespace flux {
+
+// Shared: every problem takes the smallest dt of the batch.
+// Masked: every problem takes its own dt and stops at tend, see batch_step_dt.
+enum class BatchDt { Shared, Masked };
+
+// B independent problems on the same periodic grid. The state is a Vec with
+// the problems interleaved, u[i * batch + b] is cell i of problem b, so the
+// loops over the batch are contiguous and vectorize.
+struct BatchMesh {
+    double dx;
+    std::size_t batch;
+    BatchDt dt_mode = BatchDt::Shared;
+
+    // masked mode: the end time, the time reached by each problem and its dt
+    // relative to the dt of the step, filled by batch_step_dt
+    double tend = 0;
+    std::vector<double> t{};
+    std::vector<double> scale{};
+};
+
+// interleave problems of the same length
+inline Vec batch_pack(const std::vector<std::vector<double>> &problems) {
+    std::size_t nb = problems.size();
+    std::size_t n = nb > 0 ? problems[0].size() : 0;
+    auto u = std::vector<double>(n * nb);
+    for (std::size_t b = 0; b < nb; b++) {
+        for (std::size_t i = 0; i < n; i++) { u[i * nb + b] = problems[b][i]; }
+    }
+    return Vec{u};
+}
+
+inline std::vector<std::vector<double>> batch_unpack(const Vec &var,
+                                                     std::size_t batch) {
+    std::size_t n = var.size() / batch;
+    auto problems =
+        std::vector<std::vector<double>>(batch, std::vector<double>(n));
+    for (std::size_t i = 0; i < n; i++) {
+        for (std::size_t b = 0; b < batch; b++) {
+            problems[b][i] = var[i * batch + b];
+        }
+    }
+    return problems;
+}
+
+// (fhat(u_{i-1}, u_i) - fhat(u_i, u_{i+1})) / dx of every problem, in masked
+// mode scaled by the dt of the problem relative to the dt of the step. Pass a
+// lambda without branches as fhat, so that the loop over the batch vectorizes
+// (GCC needs -fno-trapping-math to vectorize min/max).
+template <typename Flux>
+Vec batch_flux_difference(const Vec &var, const BatchMesh &ex, Flux &&fhat) {
+    const auto &u = var.data;
+    std::size_t nb = ex.batch;
+    std::size_t n = u.size() / nb;
+    double dx = ex.dx;
+    const double *scale =
+        ex.dt_mode == BatchDt::Masked ? ex.scale.data() : nullptr;
+
+    auto L = std::vector<double>(u.size());
+    parallel_for(0, n, [&](size_t i) {
+        auto idx = PeriodIndex(n, i);
+        const double *ul = u.data() + idx.l() * nb;
+        const double *uc = u.data() + idx.c() * nb;
+        const double *ur = u.data() + idx.r() * nb;
+        double *Li = L.data() + i * nb;
+
+        if (scale == nullptr) {
+            for (std::size_t b = 0; b < nb; b++) {
+                Li[b] = (fhat(ul[b], uc[b]) - fhat(uc[b], ur[b])) / dx;
+            }
+            return;
+        }
+        for (std::size_t b = 0; b < nb; b++) {
+            Li[b] = (fhat(ul[b], uc[b]) - fhat(uc[b], ur[b])) / dx * scale[b];
+        }
+    });
+    return Vec{L};
+}
+
+// cfl * dx / max|df(u)| of every problem
+template <typename DFlux>
+std::vector<double> batch_cfl_dt(const Vec &var, const BatchMesh &ex,
+                                 double cfl, DFlux &&df) {
+    std::size_t nb = ex.batch;
+    std::size_t n = var.size() / nb;
+
+    auto df_max = std::vector<double>(nb);
+    for (std::size_t i = 0; i < n; i++) {
+        const double *ui = var.data.data() + i * nb;
+        for (std::size_t b = 0; b < nb; b++) {
+            df_max[b] = std::max(df_max[b], std::abs(df(ui[b])));
+        }
+    }
+
+    for (auto &v : df_max) { v = cfl * ex.dx / v; }
+    return df_max;
+}
+
+// The dt of one step of the batch, from the dt of every problem.
+//
+// Masked mode runs the solver in a pseudo time t: the step is the smallest dt
+// of the running problems, and batch_flux_difference scales every problem by
+// its own dt / step, so each problem advances with its own dt. A problem
+// which has reached ex.tend is frozen (scale 0). Requires an operator without
+// explicit t dependence and an updater which calls get_dt once per step
+// (run() of the Euler and RK3 updaters).
+inline double batch_step_dt(const std::vector<double> &dt, BatchMesh &ex,
+                            double t) {
+    if (ex.dt_mode == BatchDt::Shared) {
+        return *std::min_element(dt.begin(), dt.end());
+    }
+
+    // the first step starts all problems at t0
+    if (ex.t.empty()) { ex.t.assign(ex.batch, t); }
+    ex.scale.assign(ex.batch, 0);
+
+    auto dt_b = std::vector<double>(ex.batch);
+    double step = std::numeric_limits<double>::max();
+    for (std::size_t b = 0; b < ex.batch; b++) {
+        if (ex.t[b] >= ex.tend) continue;
+        dt_b[b] = std::min(dt[b], ex.tend - ex.t[b]);
+        step = std::min(step, dt_b[b]);
+    }
+
+    // all problems are done, finish the pseudo time without changes
+    if (step == std::numeric_limits<double>::max()) { return ex.tend - t; }
+
+    for (std::size_t b = 0; b < ex.batch; b++) {
+        if (ex.t[b] >= ex.tend) continue;
+        ex.scale[b] = dt_b[b] / step;
+        ex.t[b] = dt_b[b] == ex.tend - ex.t[b] ? ex.tend : ex.t[b] + dt_b[b];
+    }
+    return step;
+}
+}  // namespace flux
@@ -0,0 +1,247 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#ifdef FLUX_MPI
+#include <mpi.h>
+#endif
+
+#include "thread_pool.hpp"
+
+namespace flux {
+
+// one subdomain of a Decomposition
+struct Part {
+    std::size_t index;   // local index, in [0, parts())
+    std::size_t begin;   // global index of the first owned cell
+    std::size_t cells;   // number of owned cells
+    std::size_t offset;  // position of the left ghost cells in the state
+};
+
+// Splits a periodic 1D grid of n cells into contiguous subdomains, each with
+// `halo` ghost cells on both sides. A state stores the local subdomains one
+// after the other, every block padded to a multiple of 64 bytes:
+//   [ghosts | cells of part 0 | ghosts] [ghosts | cells of part 1 | ghosts] ...
+// so the Vec arithmetic works on it unchanged. exchange() fills the ghosts
+// from the neighbours, which replaces the PeriodIndex wraparound: the local
+// operator of a subdomain only reads its own block.
+//
+// With FLUX_MPI the subdomains are distributed over the ranks of a
+// communicator, every rank stores only its own.
+class Decomposition {
+public:
+    // n cells split into `parts` subdomains, all on this process
+    Decomposition(std::size_t n, std::size_t parts, std::size_t halo,
+                  ThreadPool *pool = nullptr)
+        : m_cells(n), m_halo(halo), m_pool(pool) {
+        init(parts, 0, parts);
+    }
+
+#ifdef FLUX_MPI
+    // n cells split into parts_per_rank subdomains on every rank of comm
+    Decomposition(std::size_t n, std::size_t parts_per_rank, std::size_t halo,
+                  MPI_Comm comm, ThreadPool *pool = nullptr)
+        : m_cells(n), m_halo(halo), m_pool(pool), m_comm(comm) {
+        int rank = 0;
+        int ranks = 1;
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &ranks);
+        m_rank = static_cast<std::size_t>(rank);
+        m_ranks = static_cast<std::size_t>(ranks);
+        init(parts_per_rank * m_ranks, m_rank * parts_per_rank,
+             parts_per_rank);
+    }
+#endif
+
+    // global number of cells
+    std::size_t cells() const { return m_cells; }
+
+    std::size_t halo() const { return m_halo; }
+
+    // number of local subdomains
+    std::size_t parts() const { return m_parts.size(); }
+
+    const Part &part(std::size_t k) const { return m_parts[k]; }
+
+    // length of a local state
+    std::size_t size() const { return m_size; }
+
+    std::size_t rank() const { return m_rank; }
+
+    std::size_t ranks() const { return m_ranks; }
+
+    // the block of part p, owned cell i is local(state, p)[halo() + i]
+    std::span<double> local(std::vector<double> &state, const Part &p) const {
+        return {state.data() + p.offset, p.cells + 2 * m_halo};
+    }
+
+    std::span<const double> local(const std::vector<double> &state,
+                                  const Part &p) const {
+        return {state.data() + p.offset, p.cells + 2 * m_halo};
+    }
+
+    // the local state of the global cells, with the ghosts filled
+    std::vector<double> scatter(const std::vector<double> &global) const {
+        auto state = std::vector<double>(m_size);
+        for (const auto &p : m_parts) {
+            std::copy_n(global.begin() + static_cast<std::ptrdiff_t>(p.begin),
+                        p.cells, local(state, p).begin() + owned_begin());
+        }
+        exchange(state);
+        return state;
+    }
+
+    // the global cells from the local states of all ranks
+    std::vector<double> gather(const std::vector<double> &state) const {
+        auto global = std::vector<double>(m_cells);
+        for (const auto &p : m_parts) {
+            auto block = local(state, p);
+            std::copy_n(block.begin() + owned_begin(), p.cells,
+                        global.begin() + static_cast<std::ptrdiff_t>(p.begin));
+        }
+#ifdef FLUX_MPI
+        if (m_ranks > 1) {
+            auto counts = std::vector<int>(m_ranks);
+            auto displs = std::vector<int>(m_ranks);
+            for (std::size_t r = 0; r < m_ranks; r++) {
+                auto [begin, end] = rank_cells(r);
+                counts[r] = static_cast<int>(end - begin);
+                displs[r] = static_cast<int>(begin);
+            }
+            MPI_Allgatherv(MPI_IN_PLACE, 0, MPI_DATATYPE_NULL, global.data(),
+                           counts.data(), displs.data(), MPI_DOUBLE, m_comm);
+        }
+#endif
+        return global;
+    }
+
+    // fills the ghost cells of every local part from its neighbours, call it
+    // whenever the owned cells changed before the operator reads the ghosts
+    void exchange(std::vector<double> &state) const {
+        std::size_t num = m_parts.size();
+        std::size_t h = m_halo;
+        if (h == 0) return;
+
+        for (std::size_t k = 0; k < num; k++) {
+            auto block = local(state, m_parts[k]);
+            if (k > 0 || m_ranks == 1) {
+                auto left = local(state, m_parts[(k + num - 1) % num]);
+                std::copy_n(left.end() - 2 * static_cast<std::ptrdiff_t>(h), h,
+                            block.begin());
+            }
+            if (k + 1 < num || m_ranks == 1) {
+                auto right = local(state, m_parts[(k + 1) % num]);
+                std::copy_n(right.begin() + owned_begin(), h,
+                            block.end() - static_cast<std::ptrdiff_t>(h));
+            }
+        }
+
+#ifdef FLUX_MPI
+        if (m_ranks > 1) {
+            int left = static_cast<int>((m_rank + m_ranks - 1) % m_ranks);
+            int right = static_cast<int>((m_rank + 1) % m_ranks);
+            int count = static_cast<int>(h);
+            auto first = local(state, m_parts.front());
+            auto last = local(state, m_parts.back());
+
+            // first owned cells to the left, right ghosts from the right
+            MPI_Sendrecv(first.data() + h, count, MPI_DOUBLE, left, 0,
+                         last.data() + h + m_parts.back().cells, count,
+                         MPI_DOUBLE, right, 0, m_comm, MPI_STATUS_IGNORE);
+            // last owned cells to the right, left ghosts from the left
+            MPI_Sendrecv(last.data() + m_parts.back().cells, count, MPI_DOUBLE,
+                         right, 1, first.data(), count, MPI_DOUBLE, left, 1,
+                         m_comm, MPI_STATUS_IGNORE);
+        }
+#endif
+    }
+
+    // calls func(part) for every local part, concurrently on the pool
+    template <typename Func>
+    void for_each_part(Func &&func) const {
+        auto &pool = m_pool != nullptr ? *m_pool : ThreadPool::global();
+        pool.run(m_parts.size(), [&](std::size_t k) { func(m_parts[k]); });
+    }
+
+    // maximum of func(part) over the parts of all ranks
+    template <typename Func>
+    double max_over_parts(Func &&func) const {
+        return reduce_over_parts(func, false);
+    }
+
+    // minimum of func(part) over the parts of all ranks
+    template <typename Func>
+    double min_over_parts(Func &&func) const {
+        return reduce_over_parts(func, true);
+    }
+
+private:
+    std::size_t m_cells;
+    std::size_t m_halo;
+    ThreadPool *m_pool;
+    std::size_t m_rank = 0;
+    std::size_t m_ranks = 1;
+#ifdef FLUX_MPI
+    MPI_Comm m_comm = MPI_COMM_NULL;
+#endif
+    std::size_t m_global_parts = 0;
+    std::vector<Part> m_parts;
+    std::size_t m_size = 0;
+
+    std::ptrdiff_t owned_begin() const {
+        return static_cast<std::ptrdiff_t>(m_halo);
+    }
+
+    // global part k owns [k * n / parts, (k + 1) * n / parts)
+    std::size_t global_begin(std::size_t k) const {
+        return k * m_cells / m_global_parts;
+    }
+
+    std::pair<std::size_t, std::size_t> rank_cells(std::size_t r) const {
+        std::size_t per_rank = m_global_parts / m_ranks;
+        return {global_begin(r * per_rank), global_begin((r + 1) * per_rank)};
+    }
+
+    void init(std::size_t global_parts, std::size_t first, std::size_t num) {
+        m_global_parts = global_parts;
+        std::size_t min_cells = std::max<std::size_t>(m_halo, 1);
+        if (num == 0 || m_cells < global_parts * min_cells) {
+            throw std::invalid_argument{
+                "Decomposition: every part needs at least halo cells"};
+        }
+
+        // blocks padded to 64 bytes, they only start on a cache line if
+        // the state does, std::vector<double> is only 16-byte aligned
+        constexpr std::size_t line = 64 / sizeof(double);
+        std::size_t offset = 0;
+        for (std::size_t k = first; k < first + num; k++) {
+            std::size_t begin = global_begin(k);
+            std::size_t cells = global_begin(k + 1) - begin;
+            m_parts.push_back({k - first, begin, cells, offset});
+            offset += (cells + 2 * m_halo + line - 1) / line * line;
+        }
+        m_size = offset;
+    }
+
+    template <typename Func>
+    double reduce_over_parts(Func &func, bool min) const {
+        auto values = std::vector<double>(m_parts.size());
+        for_each_part([&](const Part &p) { values[p.index] = func(p); });
+
+        auto [lo, hi] = std::minmax_element(values.begin(), values.end());
+        double result = min ? *lo : *hi;
+#ifdef FLUX_MPI
+        if (m_ranks > 1) {
+            MPI_Allreduce(MPI_IN_PLACE, &result, 1, MPI_DOUBLE,
+                          min ? MPI_MIN : MPI_MAX, m_comm);
+        }
+#endif
+        return result;
+    }
+};
+}  // namespace flux
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+#include <type_traits>
+
+#if __has_include(<sys/mman.h>)
+#include <sys/mman.h>
+#endif
+
+#include "parallel_for.hpp"
+#include "solver/preset.hpp"
+
+namespace flux {
+
+// Huge: ask for transparent huge pages (madvise), fewer TLB misses in the
+// flux loops over large states. Only a hint, the kernel may ignore it.
+enum class PageSize { Default, Huge };
+
+// Allocator of solver states. Linux places a page on the NUMA node of the
+// thread that first writes to it, so a buffer zeroed by one thread ends up on
+// one node and the other socket reads it remotely. This allocator zeroes new
+// buffers with parallel_for and the default options, i.e. in the contiguous
+// blocks of Schedule::Static the operator loops over the cells use as well.
+// Those blocks are pinned to the threads of the pool, so a page is on the
+// node of the thread that updates it. Pages are not moved later, so the
+// serial value-initialization of the std::vector that follows does not
+// change the placement.
+//
+// The kernel may still move a thread to another node, bind the process with
+// numactl --cpunodebind or taskset so the threads stay on their node.
+template <typename T, PageSize Pages = PageSize::Default>
+class FirstTouchAllocator {
+public:
+    static_assert(std::is_trivial_v<T>, "FirstTouchAllocator: trivial types");
+
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = FirstTouchAllocator<U, Pages>;
+    };
+
+    FirstTouchAllocator() = default;
+
+    template <typename U>
+    FirstTouchAllocator(
+        const FirstTouchAllocator<U, Pages> & /*other*/) noexcept {}
+
+    T *allocate(std::size_t n) {
+        std::size_t bytes = n * sizeof(T);
+        T *p = nullptr;
+        if (use_huge_pages(bytes)) {
+            p = static_cast<T *>(
+                std::aligned_alloc(huge_page, round_up(bytes, huge_page)));
+            if (p == nullptr) { throw std::bad_alloc{}; }
+#ifdef MADV_HUGEPAGE
+            madvise(p, round_up(bytes, huge_page), MADV_HUGEPAGE);
+#endif
+        } else {
+            p = static_cast<T *>(
+                ::operator new(bytes, std::align_val_t{cache_line}));
+        }
+
+        parallel_for(0, n, [p](std::size_t i) { p[i] = T{}; });
+        return p;
+    }
+
+    void deallocate(T *p, std::size_t n) noexcept {
+        if (use_huge_pages(n * sizeof(T))) {
+            std::free(p);
+        } else {
+            ::operator delete(p, std::align_val_t{cache_line});
+        }
+    }
+
+    template <typename U>
+    bool operator==(const FirstTouchAllocator<U, Pages> & /*other*/) const {
+        return true;
+    }
+
+private:
+    static constexpr std::size_t cache_line = 64;
+    static constexpr std::size_t huge_page = std::size_t{2} << 20;
+
+    static constexpr std::size_t round_up(std::size_t bytes, std::size_t to) {
+        return (bytes + to - 1) / to * to;
+    }
+
+    // smaller buffers would only waste the rest of the huge page
+    static constexpr bool use_huge_pages(std::size_t bytes) {
+        return Pages == PageSize::Huge && bytes >= huge_page;
+    }
+};
+
+// a Vec whose storage is placed by FirstTouchAllocator
+template <PageSize Pages = PageSize::Default>
+using FirstTouchVec = BasicVec<FirstTouchAllocator<double, Pages>>;
+
+static_assert(InplaceVarRequirements<FirstTouchVec<>>,
+              "FirstTouchVec does not satisfy InplaceVarRequirements!");
+}  // namespace flux
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+
+#include "thread_pool.hpp"
+
+namespace flux {
+
+// Static: the range is split into one contiguous block per thread, block k
+// runs on thread k of the pool in every loop (ThreadPool::run_pinned).
+// Dynamic: blocks of `chunk` indices, idle threads steal the remaining
+// blocks, better for cells of uneven cost (e.g. DG cells with limiting).
+enum class Schedule { Static, Dynamic };
+
+struct ParallelOptions {
+    Schedule schedule = Schedule::Static;
+
+    // block size of Schedule::Dynamic
+    std::size_t chunk = 256;
+
+    // ranges shorter than grain run on the calling thread
+    std::size_t grain = 512;
+
+    // nullptr means ThreadPool::global()
+    ThreadPool *pool = nullptr;
+};
+
+namespace detail {
+
+struct BlockLayout {
+    std::size_t block_size;
+    std::size_t num_blocks;
+};
+
+// a single block means the loop runs on the calling thread
+inline BlockLayout block_layout(std::size_t len, const ParallelOptions &options,
+                                const ThreadPool &pool) {
+    if (len < options.grain || pool.size() == 1) { return {len, 1}; }
+
+    std::size_t block_size = std::max<std::size_t>(options.chunk, 1);
+    if (options.schedule == Schedule::Static) {
+        std::size_t num_threads = std::min(pool.size(), len);
+        block_size = (len + num_threads - 1) / num_threads;
+    }
+    return {block_size, (len + block_size - 1) / block_size};
+}
+
+inline ThreadPool &pool_of(const ParallelOptions &options) {
+    return options.pool != nullptr ? *options.pool : ThreadPool::global();
+}
+
+}  // namespace detail
+
+// Calls func(i) for every i in [begin, end). Each i is visited exactly once,
+// the order between blocks is unspecified: func(i) may read shared data but
+// only write to entries owned by i, then the result does not depend on the
+// number of threads. func may itself call parallel_for, the nested blocks
+// are scheduled on the same pool.
+template <typename Func>
+void parallel_for(std::size_t begin, std::size_t end, Func &&func,
+                  const ParallelOptions &options = {}) {
+    if (end <= begin) return;
+
+    auto &pool = detail::pool_of(options);
+    auto [block_size, num_blocks] =
+        detail::block_layout(end - begin, options, pool);
+
+    auto run_block = [&](std::size_t block) {
+        std::size_t first = begin + block * block_size;
+        std::size_t last = std::min(first + block_size, end);
+        for (std::size_t i = first; i < last; ++i) { func(i); }
+    };
+    if (options.schedule == Schedule::Static) {
+        pool.run_pinned(num_blocks, run_block);
+    } else {
+        pool.run(num_blocks, run_block);
+    }
+}
+}  // namespace flux
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "parallel_for.hpp"
+
+namespace flux {
+
+// Reduces map(i) over [begin, end) with combine, which must be associative.
+// The range is cut into leaves of options.chunk indices, every leaf is
+// reduced from left to right and the leaf results are combined in a fixed
+// pairwise tree:
+//   ((l0 + l1) + (l2 + l3)) + ((l4 + l5) + l6)
+// Neither depends on the number of threads or the schedule, so floating point
+// sums are bitwise reproducible for a given chunk, also against a serial run.
+template <typename T, typename Map, typename Combine>
+T parallel_reduce(std::size_t begin, std::size_t end, T identity, Map &&map,
+                  Combine &&combine, const ParallelOptions &options = {}) {
+    if (end <= begin) return identity;
+
+    std::size_t len = end - begin;
+    std::size_t leaf = std::max<std::size_t>(options.chunk, 1);
+    std::size_t num_leaves = (len + leaf - 1) / leaf;
+
+    // the leaves are the indices of a parallel_for, grain still counts cells
+    ParallelOptions leaf_options = options;
+    leaf_options.chunk = 1;
+    leaf_options.grain = len < options.grain ? num_leaves + 1 : 0;
+
+    // wrapped, so that T = bool gets one element per leaf
+    struct Partial {
+        T value;
+    };
+    auto partial = std::vector<Partial>(num_leaves, Partial{identity});
+    parallel_for(
+        0, num_leaves,
+        [&](std::size_t k) {
+            std::size_t first = begin + k * leaf;
+            std::size_t last = std::min(first + leaf, end);
+            T acc = map(first);
+            for (std::size_t i = first + 1; i < last; ++i) {
+                acc = combine(acc, map(i));
+            }
+            partial[k].value = acc;
+        },
+        leaf_options);
+
+    for (std::size_t stride = 1; stride < num_leaves; stride *= 2) {
+        for (std::size_t k = 0; k + stride < num_leaves; k += 2 * stride) {
+            partial[k].value =
+                combine(partial[k].value, partial[k + stride].value);
+        }
+    }
+    return combine(identity, partial[0].value);
+}
+
+// maximum of map(i) over [begin, end), the lowest value if empty
+template <typename Map>
+auto parallel_max(std::size_t begin, std::size_t end, Map &&map,
+                  const ParallelOptions &options = {}) {
+    using T = std::decay_t<decltype(map(begin))>;
+    return parallel_reduce(
+        begin, end, std::numeric_limits<T>::lowest(), map,
+        [](T a, T b) { return std::max(a, b); }, options);
+}
+
+// Pairwise: plain sums in the leaves, pairwise over the leaves.
+// Kahan: every addition also carries its rounding error (Kahan-Babuska),
+// the error is then of the order of one rounding, independent of n.
+enum class Summation { Pairwise, Kahan };
+
+namespace detail {
+
+struct CompensatedSum {
+    double sum;
+    double error;
+};
+
+// TwoSum: s + e == a + b exactly
+inline CompensatedSum compensated_add(CompensatedSum a, CompensatedSum b) {
+    double s = a.sum + b.sum;
+    double bb = s - a.sum;
+    double e = (a.sum - (s - bb)) + (b.sum - bb);
+    return {s, a.error + b.error + e};
+}
+
+}  // namespace detail
+
+// sum of map(i) over [begin, end), in the fixed order of parallel_reduce
+template <typename Map>
+double parallel_sum(std::size_t begin, std::size_t end, Map &&map,
+                    Summation summation = Summation::Pairwise,
+                    const ParallelOptions &options = {}) {
+    if (summation == Summation::Pairwise) {
+        return parallel_reduce(
+            begin, end, 0.0, map, [](double a, double b) { return a + b; },
+            options);
+    }
+    auto result = parallel_reduce(
+        begin, end, detail::CompensatedSum{0.0, 0.0},
+        [&](std::size_t i) { return detail::CompensatedSum{map(i), 0.0}; },
+        detail::compensated_add, options);
+    return result.sum + result.error;
+}
+}  // namespace flux
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "thread_pool.hpp"
+
+namespace flux {
+
+// A directed acyclic graph of tasks. run() starts every task as soon as the
+// tasks it depends on are done, there is no barrier between the levels of
+// the graph:
+//   TaskGraph graph;
+//   auto a = graph.add([&]() { ... });
+//   auto b = graph.add([&]() { ... });
+//   graph.depend(b, a);  // b after a
+//   graph.run(pool);
+// The graph can be run again, e.g. once per time step.
+class TaskGraph {
+public:
+    using Node = std::size_t;
+
+    template <typename Func>
+    Node add(Func &&func) {
+        m_tasks.push_back({std::forward<Func>(func), {}, 0});
+        return m_tasks.size() - 1;
+    }
+
+    // task runs after `on` is done, adding the same edge twice is harmless
+    void depend(Node task, Node on) {
+        auto &successors = m_tasks[on].successors;
+        for (Node s : successors) {
+            if (s == task) return;
+        }
+        successors.push_back(task);
+        m_tasks[task].num_deps++;
+    }
+
+    std::size_t size() const { return m_tasks.size(); }
+
+    // returns when all tasks are done, the first exception thrown by a task
+    // is rethrown here and the tasks depending on it are skipped
+    void run(ThreadPool &pool) {
+        // kept for the next run unless tasks were added
+        if (m_num_remaining != m_tasks.size()) {
+            m_remaining =
+                std::make_unique<std::atomic<std::size_t>[]>(m_tasks.size());
+            m_num_remaining = m_tasks.size();
+        }
+        for (Node k = 0; k < m_tasks.size(); k++) {
+            m_remaining[k] = m_tasks[k].num_deps;
+        }
+
+        TaskGroup group{pool};
+        m_group = &group;
+        for (Node k = 0; k < m_tasks.size(); k++) {
+            if (m_tasks[k].num_deps == 0) { spawn(k); }
+        }
+        group.wait();
+    }
+
+private:
+    struct Task {
+        std::function<void()> func;
+        std::vector<Node> successors;
+        std::size_t num_deps;
+    };
+
+    std::vector<Task> m_tasks;
+    std::unique_ptr<std::atomic<std::size_t>[]> m_remaining;
+    std::size_t m_num_remaining = 0;
+    TaskGroup *m_group = nullptr;  // of the current run()
+
+    // the successors are spawned before the task is done, so the group
+    // cannot finish early; [this, k] is small enough for std::function not
+    // to allocate
+    void spawn(Node k) {
+        m_group->spawn([this, k]() {
+            m_tasks[k].func();
+            for (Node s : m_tasks[k].successors) {
+                if (--m_remaining[s] == 0) { spawn(s); }
+            }
+        });
+    }
+};
+}  // namespace flux
@@ -0,0 +1,341 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace flux {
+
+class ThreadPool;
+class TaskGroup;
+
+namespace detail {
+
+struct Task {
+    std::function<void()> func;
+    TaskGroup *group;
+    bool pinned = false;  // see ThreadPool::run_pinned
+};
+
+// The owner pushes and pops at the back (newest first, cache-warm), the
+// other threads steal from the front, i.e. the oldest and largest tasks.
+class WorkDeque {
+public:
+    void push(Task task) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_tasks.push_back(std::move(task));
+    }
+
+    std::optional<Task> pop() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_tasks.empty()) return std::nullopt;
+        Task task = std::move(m_tasks.back());
+        m_tasks.pop_back();
+        return task;
+    }
+
+    // the oldest task, a pinned one only if pinned is true and the owner
+    // is running another task, checked under the lock so that a task pushed
+    // after the owner is done is not taken
+    std::optional<Task> steal(bool pinned) {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        pinned = pinned && m_running > 0;
+        auto it = std::find_if(m_tasks.begin(), m_tasks.end(), [&](auto &t) {
+            return pinned || !t.pinned;
+        });
+        if (it == m_tasks.end()) return std::nullopt;
+        Task task = std::move(*it);
+        m_tasks.erase(it);
+        return task;
+    }
+
+    // the owner of the deque is running a task (nested ones counted)
+    void begin_task() { m_running++; }
+
+    void end_task() { m_running--; }
+
+private:
+    std::mutex m_mutex;
+    std::deque<Task> m_tasks;
+    std::atomic<std::size_t> m_running{0};
+};
+
+// the pool and deque index of the current thread, if it is a worker
+struct WorkerInfo {
+    const ThreadPool *pool = nullptr;
+    std::size_t index = 0;
+};
+
+inline WorkerInfo &current_worker() {
+    thread_local WorkerInfo info;
+    return info;
+}
+
+}  // namespace detail
+
+// Work-stealing scheduler shared by all parallel loops of flux. Every worker
+// owns a deque of tasks, idle workers steal from the others, and threads
+// outside the pool submit through one more shared deque. A thread waiting for
+// a TaskGroup executes tasks meanwhile, so tasks may spawn and wait for
+// nested tasks without blocking a worker.
+class ThreadPool {
+public:
+    // num_threads counts the calling thread, 1 means no worker threads
+    explicit ThreadPool(std::size_t num_threads = default_num_threads()) {
+        num_threads = std::max<std::size_t>(num_threads, 1);
+        for (std::size_t i = 0; i < num_threads; ++i) {
+            m_deques.push_back(std::make_unique<detail::WorkDeque>());
+        }
+        for (std::size_t i = 0; i + 1 < num_threads; ++i) {
+            m_workers.emplace_back([this, i]() { worker_loop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool &) = delete;
+
+    ThreadPool &operator=(const ThreadPool &) = delete;
+
+    ~ThreadPool() {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+        m_wake.notify_all();
+        for (auto &worker : m_workers) { worker.join(); }
+    }
+
+    std::size_t size() const { return m_workers.size() + 1; }
+
+    // calls func(task) for every task in [0, num_tasks) and returns when all
+    // are done, the first exception thrown by a task is rethrown here
+    template <typename Func>
+    void run(std::size_t num_tasks, Func &&func);
+
+    // run with task k on thread k % size(), i.e. on worker k and the last
+    // one on the calling thread. Another thread takes a pinned task only
+    // while its thread is busy with other work, so with at most size() tasks
+    // the same k runs on the same thread in every call, e.g. the blocks of
+    // Schedule::Static.
+    template <typename Func>
+    void run_pinned(std::size_t num_tasks, Func &&func);
+
+    // FLUX_NUM_THREADS if set, otherwise the number of hardware threads
+    static std::size_t default_num_threads() {
+        if (const char *env = std::getenv("FLUX_NUM_THREADS")) {
+            auto num = std::strtoul(env, nullptr, 10);
+            if (num > 0) { return num; }
+        }
+        return std::max(std::thread::hardware_concurrency(), 1U);
+    }
+
+    // shared by the parallel loops unless they are given a pool. It is never
+    // destroyed: a forked child has none of its workers to join, and static
+    // destructors may still run parallel loops at exit.
+    static ThreadPool &global() {
+        static auto *pool = new ThreadPool;
+        return *pool;
+    }
+
+private:
+    friend class TaskGroup;
+
+    // the last deque takes the tasks of threads outside the pool
+    std::vector<std::unique_ptr<detail::WorkDeque>> m_deques;
+    std::vector<std::thread> m_workers;
+    std::mutex m_mutex;
+    std::condition_variable m_wake;
+    std::size_t m_queued = 0;  // tasks in all deques, guarded by m_mutex
+    bool m_stop = false;
+
+    std::size_t own_deque() const {
+        const auto &info = detail::current_worker();
+        return info.pool == this ? info.index : m_deques.size() - 1;
+    }
+
+    void submit(detail::Task task) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queued++;
+        }
+        m_deques[own_deque()]->push(std::move(task));
+        m_wake.notify_one();
+    }
+
+    // no wake-up, run_pinned wakes all workers after the last task
+    void submit_pinned(detail::Task task, std::size_t thread) {
+        task.pinned = true;
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queued++;
+        }
+        std::size_t deque = thread + 1 < size() ? thread : own_deque();
+        m_deques[deque]->push(std::move(task));
+    }
+
+    // own deque first, then steal round-robin starting at the next deque.
+    // The pinned tasks of an idle worker are left to it, those of the
+    // threads outside the pool to the thread waiting for them.
+    std::optional<detail::Task> find_task() {
+        std::size_t self = own_deque();
+        auto task = m_deques[self]->pop();
+        for (std::size_t k = 1; !task && k < m_deques.size(); ++k) {
+            std::size_t other = (self + k) % m_deques.size();
+            task = m_deques[other]->steal(other + 1 < m_deques.size());
+        }
+        if (task) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_queued--;
+        }
+        return task;
+    }
+
+    bool run_one();
+
+    void worker_loop(std::size_t index) {
+        detail::current_worker() = {this, index};
+        while (true) {
+            if (run_one()) continue;
+
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_wake.wait(lock, [&]() { return m_stop || m_queued > 0; });
+            if (m_stop) return;
+        }
+    }
+};
+
+// A set of tasks to wait for:
+//   TaskGroup group{pool};
+//   group.spawn([&]() { ... });
+//   group.wait();  // runs pending tasks, rethrows the first exception
+class TaskGroup {
+public:
+    explicit TaskGroup(ThreadPool &pool) : m_pool(pool) {}
+
+    TaskGroup(const TaskGroup &) = delete;
+
+    TaskGroup &operator=(const TaskGroup &) = delete;
+
+    ~TaskGroup() {
+        try {
+            wait();
+        }
+        catch (...) {}
+    }
+
+    template <typename Func>
+    void spawn(Func &&func) {
+        m_pending++;
+        m_pool.submit({std::forward<Func>(func), this});
+    }
+
+    void wait() {
+        while (m_pending > 0) {
+            if (m_pool.run_one()) continue;
+
+            // nothing to steal, the remaining tasks are running elsewhere
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_done.wait_for(lock, std::chrono::microseconds(100),
+                            [&]() { return m_pending == 0; });
+        }
+        // the last task may still hold m_mutex
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (m_error) {
+            std::rethrow_exception(std::exchange(m_error, nullptr));
+        }
+    }
+
+private:
+    friend class ThreadPool;
+
+    ThreadPool &m_pool;
+    std::atomic<std::size_t> m_pending{0};
+    std::mutex m_mutex;
+    std::condition_variable m_done;
+    std::exception_ptr m_error;
+
+    template <typename Func>
+    void spawn_pinned(Func &&func, std::size_t thread) {
+        m_pending++;
+        m_pool.submit_pinned({std::forward<Func>(func), this}, thread);
+    }
+
+    void execute(std::function<void()> &func) {
+        try {
+            func();
+        }
+        catch (...) {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            if (!m_error) { m_error = std::current_exception(); }
+        }
+    }
+
+    void finish() {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pending == 0) { m_done.notify_all(); }
+    }
+};
+
+// the thread is idle again before the group is done, so its pinned tasks
+// of the next call are not stolen
+inline bool ThreadPool::run_one() {
+    auto task = find_task();
+    if (!task) return false;
+    auto &self = *m_deques[own_deque()];
+    self.begin_task();
+    task->group->execute(task->func);
+    self.end_task();
+    task->group->finish();
+    return true;
+}
+
+template <typename Func>
+void ThreadPool::run(std::size_t num_tasks, Func &&func) {
+    if (num_tasks == 0) return;
+    if (num_tasks == 1 || m_workers.empty()) {
+        for (std::size_t task = 0; task < num_tasks; ++task) { func(task); }
+        return;
+    }
+
+    // split [first, last) in halves, the thieves take the large halves
+    std::function<void(std::size_t, std::size_t)> split;
+    TaskGroup group{*this};
+    split = [&](std::size_t first, std::size_t last) {
+        while (last - first > 1) {
+            std::size_t mid = first + (last - first) / 2;
+            group.spawn([&split, mid, last]() { split(mid, last); });
+            last = mid;
+        }
+        func(first);
+    };
+    group.spawn([&]() { split(0, num_tasks); });
+    group.wait();
+}
+
+template <typename Func>
+void ThreadPool::run_pinned(std::size_t num_tasks, Func &&func) {
+    if (num_tasks == 0) return;
+    if (num_tasks == 1 || m_workers.empty()) {
+        for (std::size_t task = 0; task < num_tasks; ++task) { func(task); }
+        return;
+    }
+
+    TaskGroup group{*this};
+    for (std::size_t task = 0; task < num_tasks; ++task) {
+        group.spawn_pinned([&func, task]() { func(task); }, task % size());
+    }
+    m_wake.notify_all();
+    group.wait();
+}
+}  // namespace flux
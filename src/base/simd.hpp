@@ -0,0 +1,115 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstring>
+
+// GCC and Clang vector extensions, element by element otherwise
+#if defined(__GNUC__) || defined(__clang__)
+#define FLUX_VECTOR_EXTENSIONS
+#endif
+
+namespace flux {
+
+// doubles in one SIMD register of the target, see FLUX_NATIVE
+#if defined(__AVX512F__)
+inline constexpr std::size_t simd_width = 8;
+#elif defined(__AVX__)
+inline constexpr std::size_t simd_width = 4;
+#else
+inline constexpr std::size_t simd_width = 2;  // SSE2, NEON
+#endif
+
+namespace detail {
+// W doubles in the registers of the vector extensions, element by element in
+// a std::array for the other widths and compilers
+template <std::size_t W>
+struct PackStorage {
+    using type = std::array<double, W>;
+    static constexpr bool native = false;
+};
+
+#ifdef FLUX_VECTOR_EXTENSIONS
+// the vector size cannot depend on a template parameter in GCC
+template <>
+struct PackStorage<2> {
+    using type = double __attribute__((vector_size(16)));
+    static constexpr bool native = true;
+};
+
+template <>
+struct PackStorage<4> {
+    using type = double __attribute__((vector_size(32)));
+    static constexpr bool native = true;
+};
+
+template <>
+struct PackStorage<8> {
+    using type = double __attribute__((vector_size(64)));
+    static constexpr bool native = true;
+};
+#endif
+}  // namespace detail
+
+// W doubles, with the vector extensions and W of 2, 4 or 8 every operation
+// is one instruction on all of them. The operations are the IEEE operations
+// of double element by element, so a kernel written for a type T gives
+// bitwise the same results with T = double and T = Pack<W>. A double
+// converts to a Pack with all elements equal.
+template <std::size_t W = simd_width>
+class Pack {
+public:
+    static constexpr std::size_t width = W;
+
+    Pack() = default;
+
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    Pack(double d) {
+        for (std::size_t i = 0; i < W; i++) { m_v[i] = d; }
+    }
+
+    // p[0], ..., p[W - 1], no alignment needed
+    static Pack load(const double *p) {
+        Pack pack;
+        std::memcpy(&pack.m_v, p, sizeof(pack.m_v));
+        return pack;
+    }
+
+    void store(double *p) const { std::memcpy(p, &m_v, sizeof(m_v)); }
+
+    double operator[](std::size_t i) const { return m_v[i]; }
+
+    friend Pack operator+(Pack a, Pack b) {
+        return map(a, b, [](auto x, auto y) { return x + y; });
+    }
+
+    friend Pack operator-(Pack a, Pack b) {
+        return map(a, b, [](auto x, auto y) { return x - y; });
+    }
+
+    friend Pack operator*(Pack a, Pack b) {
+        return map(a, b, [](auto x, auto y) { return x * y; });
+    }
+
+    friend Pack operator/(Pack a, Pack b) {
+        return map(a, b, [](auto x, auto y) { return x / y; });
+    }
+
+private:
+    using Storage = detail::PackStorage<W>;
+
+    typename Storage::type m_v;
+
+    template <typename Op>
+    static Pack map(Pack a, Pack b, Op op) {
+        if constexpr (Storage::native) {
+            a.m_v = op(a.m_v, b.m_v);
+        } else {
+            for (std::size_t i = 0; i < W; i++) {
+                a.m_v[i] = op(a.m_v[i], b.m_v[i]);
+            }
+        }
+        return a;
+    }
+};
+}  // namespace flux
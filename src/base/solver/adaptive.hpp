@@ -0,0 +1,161 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <utility>
+
+namespace flux {
+
+// the error norm reads VarType element by element
+template <typename T>
+concept IndexableVarRequirements = requires(const T &a, std::size_t i) {
+    { a.size() } -> std::convertible_to<std::size_t>;
+    { a[i] } -> std::convertible_to<double>;
+};
+
+struct AdaptiveOptions {
+    double atol = 1e-6;
+    double rtol = 1e-6;
+    double safety = 0.9;
+    double fac_min = 0.2;  // bounds of dt_new / dt
+    double fac_max = 5.0;
+    double dt_min = 1e-12;  // give up below this step size
+    bool cfl_limit = true;  // never exceed get_dt (stability of SSP methods)
+};
+
+// PI step size controller (Gustafsson) for an embedded pair whose lower
+// order is q. It proposes the next dt and counts accepted/rejected steps.
+class AdaptiveController {
+public:
+    explicit AdaptiveController(AdaptiveOptions options = {}, int q = 2)
+        : m_options(options), m_k(q + 1) {}
+
+    const AdaptiveOptions &options() const { return m_options; }
+
+    // dt of the next attempt, dt_max is the estimate of get_dt
+    double next_dt(double dt_max) const {
+        if (m_dt <= 0) return dt_max;
+        return m_options.cfl_limit ? std::min(m_dt, dt_max) : m_dt;
+    }
+
+    // scaled error of a step with size dt, err <= 1 is accepted
+    bool accept(double err, double dt) {
+        const auto &opt = m_options;
+
+        if (err <= 1) {
+            double fac = opt.fac_max;
+            if (err > 0) {
+                fac = opt.safety * std::pow(err, -0.7 / m_k)
+                      * std::pow(m_err_prev, 0.4 / m_k);
+            }
+            m_dt = dt * std::clamp(fac, opt.fac_min, opt.fac_max);
+            m_err_prev = std::max(err, 1e-4);
+            m_dt_last = dt;
+            m_accepted++;
+            return true;
+        }
+
+        double fac = opt.fac_min;
+        if (!std::isnan(err)) {
+            fac = std::clamp(opt.safety * std::pow(err, -1.0 / m_k),
+                             opt.fac_min, 1.0);
+        }
+        m_dt = dt * fac;
+        m_rejected++;
+        if (m_dt < opt.dt_min) { m_failed = true; }
+        return false;
+    }
+
+    bool failed() const { return m_failed; }
+
+    // dt of the last accepted step
+    double last_dt() const { return m_dt_last; }
+
+    std::size_t accepted() const { return m_accepted; }
+
+    std::size_t rejected() const { return m_rejected; }
+
+private:
+    AdaptiveOptions m_options;
+    double m_k;
+    double m_dt = 0;  // proposed dt, 0 before the first step
+    double m_dt_last = 0;
+    double m_err_prev = 1;
+    std::size_t m_accepted = 0;
+    std::size_t m_rejected = 0;
+    bool m_failed = false;
+};
+
+// RMS of (u - u_hat) / (atol + rtol * max(|u_n|, |u|))
+template <IndexableVarRequirements VarType>
+double error_norm(const VarType &var_n, const VarType &var,
+                  const VarType &var_hat, const AdaptiveOptions &options) {
+    std::size_t n = var.size();
+    if (n == 0) return 0;
+
+    double sum = 0;
+    for (std::size_t i = 0; i < n; i++) {
+        double scale = options.atol
+                       + options.rtol
+                             * std::max(std::abs(var_n[i]), std::abs(var[i]));
+        double e = (var[i] - var_hat[i]) / scale;
+        sum += e * e;
+    }
+    return std::sqrt(sum / static_cast<double>(n));
+}
+
+// SSPRK(3,3) with the embedded second order solution (Heun)
+// u_hat = 1/2 u^n + 1/2 (u^(1) + dt L(u^(1)))
+// returns {u^{n+1}, u_hat}, the hooks are the same as shu_osher_step.
+template <typename VarType, typename OpType, typename StageType>
+std::pair<VarType, VarType> ssprk32_step(const VarType &var_n, double t,
+                                         double dt, const OpType &op_L,
+                                         const StageType &post_process_rk_stage) {
+    VarType var1 = var_n + dt * op_L(var_n, t);
+    var1 = post_process_rk_stage(var1, t);
+
+    VarType L1 = op_L(var1, t + dt);
+    VarType var_hat = (1.0 / 2) * var_n + (1.0 / 2) * (var1 + dt * L1);
+    VarType var2 = (3.0 / 4) * var_n + (1.0 / 4) * (var1 + dt * L1);
+    var2 = post_process_rk_stage(var2, t + dt);
+
+    VarType var3 = (1.0 / 3) * var_n + (2.0 / 3) * (var2 + dt * op_L(var2, t + dt / 2));
+    var3 = post_process_rk_stage(var3, t + dt / 2);
+
+    return {std::move(var3), std::move(var_hat)};
+}
+
+// Attempts steps from (var_n, t) until one is accepted, rejected steps are
+// simply discarded. On success t is advanced and the new state is returned,
+// if dt falls below dt_min controller.failed() is set and var_n is returned.
+template <IndexableVarRequirements VarType, typename OpType, typename StageType>
+VarType adaptive_rk32_step(const VarType &var_n, AdaptiveController &controller,
+                           double &t, bool &stop_flag, double tend,
+                           double dt_max, const OpType &op_L,
+                           const StageType &post_process_rk_stage) {
+    while (true) {
+        double dt = controller.next_dt(dt_max);
+        bool last = false;
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            last = true;
+        }
+
+        auto [var, var_hat] = ssprk32_step(var_n, t, dt, op_L,
+                                           post_process_rk_stage);
+        double err = error_norm(var_n, var, var_hat, controller.options());
+
+        if (controller.accept(err, dt)) {
+            t += dt;
+            stop_flag = last;
+            return var;
+        }
+        if (controller.failed()) {
+            stop_flag = true;
+            return var_n;
+        }
+    }
+}
+}  // namespace flux
@@ -0,0 +1,234 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <iterator>
+#include <span>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "expected.hpp"
+#include "observer.hpp"
+
+namespace flux {
+
+// Everything needed to resume run(): the state, t, the step index and
+// user-defined solver parameters (e.g. dx, cfl) to check on restart.
+struct Checkpoint {
+    double t = 0;
+    std::uint64_t step = 0;
+    std::vector<double> params;
+    std::vector<double> data;
+};
+
+namespace detail {
+
+inline constexpr char checkpoint_magic[8] = {'F', 'L', 'U', 'X',
+                                             'C', 'K', 'P', '1'};
+
+// FNV-1a, detects truncated or corrupted files
+inline std::uint64_t checkpoint_hash(const std::vector<char> &bytes) {
+    std::uint64_t hash = 14695981039346656037ULL;
+    for (char c : bytes) {
+        hash ^= static_cast<unsigned char>(c);
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+template <typename T>
+void checkpoint_put(std::vector<char> &bytes, const T *values,
+                    std::size_t num) {
+    const auto *p = reinterpret_cast<const char *>(values);
+    bytes.insert(bytes.end(), p, p + num * sizeof(T));
+}
+
+template <typename T>
+bool checkpoint_get(const std::vector<char> &bytes, std::size_t &pos,
+                    T *values, std::size_t num) {
+    if (num > (bytes.size() - pos) / sizeof(T)) return false;
+    std::memcpy(values, bytes.data() + pos, num * sizeof(T));
+    pos += num * sizeof(T);
+    return true;
+}
+
+}  // namespace detail
+
+// Binary layout (native byte order): magic, step, t, number of params,
+// number of values, params, values, hash of all previous bytes.
+// The file is written to path + ".tmp" first and then renamed, so an
+// interrupted write never destroys the previous checkpoint.
+inline auto write_checkpoint(const std::string &path, double t,
+                             std::uint64_t step, std::span<const double> params,
+                             std::span<const double> data)
+    -> flux::expected<std::size_t, std::string> {
+    std::vector<char> bytes;
+    bytes.reserve(48 + (params.size() + data.size()) * sizeof(double));
+
+    std::uint64_t num_params = params.size();
+    std::uint64_t num_data = data.size();
+    detail::checkpoint_put(bytes, detail::checkpoint_magic, 8);
+    detail::checkpoint_put(bytes, &step, 1);
+    detail::checkpoint_put(bytes, &t, 1);
+    detail::checkpoint_put(bytes, &num_params, 1);
+    detail::checkpoint_put(bytes, &num_data, 1);
+    detail::checkpoint_put(bytes, params.data(), params.size());
+    detail::checkpoint_put(bytes, data.data(), data.size());
+    std::uint64_t hash = detail::checkpoint_hash(bytes);
+    detail::checkpoint_put(bytes, &hash, 1);
+
+    std::string tmp_path = path + ".tmp";
+    {
+        std::ofstream f(tmp_path, std::ios::binary | std::ios::trunc);
+        if (f.fail()) {
+            return flux::unexpected{std::string{"fail to open file "}
+                                    + tmp_path};
+        }
+        f.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+        if (f.fail()) {
+            return flux::unexpected{std::string{"fail to write file "}
+                                    + tmp_path};
+        }
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(tmp_path, path, ec);
+    if (ec) {
+        return flux::unexpected{std::string{"fail to rename file "} + tmp_path};
+    }
+
+    return bytes.size();
+}
+
+inline auto read_checkpoint(const std::string &path)
+    -> flux::expected<Checkpoint, std::string> {
+    std::ifstream f(path, std::ios::binary);
+    if (f.fail()) {
+        return flux::unexpected{std::string{"fail to open file "} + path};
+    }
+    std::vector<char> bytes((std::istreambuf_iterator<char>(f)),
+                            std::istreambuf_iterator<char>());
+
+    auto bad_file = [&]() {
+        return flux::unexpected{std::string{"invalid checkpoint file "} + path};
+    };
+
+    char magic[8];
+    Checkpoint cp;
+    std::uint64_t num_params = 0;
+    std::uint64_t num_data = 0;
+    std::size_t pos = 0;
+    if (!detail::checkpoint_get(bytes, pos, magic, 8)
+        || std::memcmp(magic, detail::checkpoint_magic, 8) != 0
+        || !detail::checkpoint_get(bytes, pos, &cp.step, 1)
+        || !detail::checkpoint_get(bytes, pos, &cp.t, 1)
+        || !detail::checkpoint_get(bytes, pos, &num_params, 1)
+        || !detail::checkpoint_get(bytes, pos, &num_data, 1)) {
+        return bad_file();
+    }
+
+    std::size_t body = bytes.size() - pos;
+    if (num_params > body / sizeof(double)
+        || num_data > body / sizeof(double) - num_params) {
+        return bad_file();
+    }
+    cp.params.resize(num_params);
+    cp.data.resize(num_data);
+    if (!detail::checkpoint_get(bytes, pos, cp.params.data(), num_params)
+        || !detail::checkpoint_get(bytes, pos, cp.data.data(), num_data)) {
+        return bad_file();
+    }
+
+    std::uint64_t hash = 0;
+    std::size_t end = pos;
+    if (!detail::checkpoint_get(bytes, pos, &hash, 1) || pos != bytes.size()) {
+        return bad_file();
+    }
+    bytes.resize(end);
+    if (hash != detail::checkpoint_hash(bytes)) { return bad_file(); }
+
+    return cp;
+}
+
+// Writes a checkpoint every `interval` steps in the background. As an
+// observer (post_step) it works with every framework, a snapshot copies
+// the state once and at most one write is in flight.
+// Restart: read_checkpoint(path), then run(VarType{cp.data}, ex, cp.t, tend)
+// reproduces the remaining steps bit for bit, pass cp.step as step0 to keep
+// the step index. This needs an updater that calls the observers (all the
+// updaters of the frameworks do, PararealSolver does not), and an adaptive
+// run restarts with a fresh controller, so its step sizes differ.
+// The destructor waits for the last write but drops its error, call wait()
+// to see it.
+class Checkpointer : public ObserverBase {
+public:
+    Checkpointer(std::string path, std::size_t interval,
+                 std::vector<double> params = {}, std::uint64_t step0 = 0)
+        : m_path(std::move(path)), m_interval(interval),
+          m_params(std::move(params)), m_step(step0) {}
+
+    Checkpointer(const Checkpointer &) = delete;
+
+    Checkpointer &operator=(const Checkpointer &) = delete;
+
+    ~Checkpointer() override {
+        try {
+            wait();
+        }
+        catch (...) {}
+    }
+
+    void post_step(std::span<const double> var, double t, double dt) override {
+        m_step++;
+        if (m_interval > 0 && m_step % m_interval == 0) { save(var, t); }
+    }
+
+    // snapshot now, the file is written asynchronously
+    void save(std::span<const double> var, double t) {
+        wait();
+        m_pending = std::async(
+            std::launch::async,
+            [path = m_path, params = m_params, step = m_step, t,
+             data = std::vector<double>(var.begin(), var.end())]() {
+                return write_checkpoint(path, t, step, params, data);
+            });
+    }
+
+    // waits for the write in flight, returns false if any write failed,
+    // an exception thrown by the write is recorded in error() as well
+    bool wait() {
+        if (m_pending.valid()) {
+            try {
+                auto res = m_pending.get();
+                if (res.has_value()) { m_written++; }
+                else { m_error = res.error(); }
+            }
+            catch (const std::exception &e) {
+                m_error = std::string{"fail to write checkpoint: "} + e.what();
+            }
+        }
+        return m_error.empty();
+    }
+
+    std::uint64_t step() const { return m_step; }
+
+    std::size_t written() const { return m_written; }
+
+    const std::string &error() const { return m_error; }
+
+private:
+    std::string m_path;
+    std::size_t m_interval;
+    std::vector<double> m_params;
+    std::uint64_t m_step;
+    std::future<flux::expected<std::size_t, std::string>> m_pending;
+    std::size_t m_written = 0;
+    std::string m_error;
+};
+}  // namespace flux
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <utility>
+#include <vector>
+
+#include "requires.h"
+
+namespace flux {
+
+// Continuous extension of SSP-RK3 (second order in theta)
+// u(t + theta * dt) = u^n + dt * (b1 L(u^n) + b2 L(u^(1)) + b3 L(u^(2)))
+// b1 = theta - 5/6 theta^2, b2 = 1/6 theta^2, b3 = 2/3 theta^2
+// Reports the state at sorted output times while run() takes its usual
+// steps, only tend truncates the last step.
+template <VarRequirements VarType>
+class DenseOutput {
+public:
+    using OutputFunc = std::function<void(double, const VarType &)>;
+
+    DenseOutput(std::vector<double> times, OutputFunc output)
+        : m_times(std::move(times)), m_output(std::move(output)) {
+        std::sort(m_times.begin(), m_times.end());
+    }
+
+    // skip times before t0, report the initial state at t0
+    void start(const VarType &var, double t0) {
+        while (m_next < m_times.size() && m_times[m_next] < t0) { m_next++; }
+        while (m_next < m_times.size() && m_times[m_next] == t0) {
+            m_output(t0, var);
+            m_next++;
+        }
+    }
+
+    // one RK3 step from (var_n, t) to (var, t + dt) with the stage derivatives
+    void add_rk3_step(const VarType &var_n, double t, double dt,
+                      const VarType &L0, const VarType &L1, const VarType &L2,
+                      const VarType &var) {
+        while (m_next < m_times.size() && m_times[m_next] <= t + dt) {
+            double tau = m_times[m_next];
+            if (tau == t + dt) { m_output(tau, var); }
+            else {
+                double theta = (tau - t) / dt;
+                double b1 = theta - 5.0 / 6 * theta * theta;
+                double b2 = 1.0 / 6 * theta * theta;
+                double b3 = 2.0 / 3 * theta * theta;
+                m_output(tau, VarType(var_n + (dt * b1) * L0 + (dt * b2) * L1
+                                      + (dt * b3) * L2));
+            }
+            m_next++;
+        }
+    }
+
+    // number of reported times
+    std::size_t count() const { return m_next; }
+
+private:
+    std::vector<double> m_times;
+    OutputFunc m_output;
+    std::size_t m_next = 0;
+};
+
+// the SSP-RK3 step of RK3Solver::update, recording the step into dense
+template <typename VarType, typename OpType, typename StageType,
+          typename PostProcessType>
+VarType ssprk3_dense_step(const VarType &var_n, double t, double dt,
+                          const OpType &op_L,
+                          const StageType &post_process_rk_stage,
+                          const PostProcessType &post_process,
+                          DenseOutput<VarType> &dense) {
+    VarType L0 = op_L(var_n, t);
+    VarType var1 = var_n + dt * L0;
+    var1 = post_process_rk_stage(var1, t);
+
+    VarType L1 = op_L(var1, t + dt);
+    VarType var2 = (3.0 / 4) * var_n + (1.0 / 4) * (var1 + dt * L1);
+    var2 = post_process_rk_stage(var2, t + dt);
+
+    VarType L2 = op_L(var2, t + dt / 2);
+    VarType var3 = (1.0 / 3) * var_n + (2.0 / 3) * (var2 + dt * L2);
+    var3 = post_process_rk_stage(var3, t + dt / 2);
+    var3 = post_process(var3, t + dt);
+
+    dense.add_rk3_step(var_n, t, dt, L0, L1, L2, var3);
+    return var3;
+}
+}  // namespace flux
@@ -0,0 +1,127 @@
+#pragma once
+
+#include <coroutine>
+#include <cstddef>
+#include <exception>
+#include <iterator>
+#include <memory>
+#include <utility>
+
+// NOLINTBEGIN(readability-identifier-naming)
+
+namespace flux {
+
+// A minimal replacement of C++23 std::generator for input iteration.
+// Values are yielded by reference, the referenced object lives in the
+// coroutine frame until the consumer resumes it.
+template <typename T>
+class generator {
+public:
+    struct promise_type {
+        const T *m_value = nullptr;
+        std::exception_ptr m_exception;
+
+        generator get_return_object() {
+            return generator{
+                std::coroutine_handle<promise_type>::from_promise(*this)};
+        }
+
+        std::suspend_always initial_suspend() noexcept { return {}; }
+
+        std::suspend_always final_suspend() noexcept { return {}; }
+
+        std::suspend_always yield_value(const T &value) noexcept {
+            m_value = std::addressof(value);
+            return {};
+        }
+
+        void return_void() {}
+
+        void unhandled_exception() { m_exception = std::current_exception(); }
+
+        // no co_await in generators
+        template <typename U>
+        std::suspend_never await_transform(U &&value) = delete;
+    };
+
+    class iterator {
+    public:
+        using iterator_category = std::input_iterator_tag;
+        using difference_type = std::ptrdiff_t;
+        using value_type = T;
+
+        iterator() = default;
+
+        explicit iterator(std::coroutine_handle<promise_type> handle)
+            : m_handle(handle) {}
+
+        const T &operator*() const { return *m_handle.promise().m_value; }
+
+        const T *operator->() const { return m_handle.promise().m_value; }
+
+        iterator &operator++() {
+            advance(m_handle);
+            return *this;
+        }
+
+        void operator++(int) { ++*this; }
+
+        bool operator==(std::default_sentinel_t) const {
+            return !m_handle || m_handle.done();
+        }
+
+    private:
+        std::coroutine_handle<promise_type> m_handle;
+    };
+
+    generator(const generator &) = delete;
+
+    generator &operator=(const generator &) = delete;
+
+    generator(generator &&rhs) noexcept
+        : m_handle(std::exchange(rhs.m_handle, {})) {}
+
+    generator &operator=(generator &&rhs) noexcept {
+        if (this != &rhs) {
+            if (m_handle) { m_handle.destroy(); }
+            m_handle = std::exchange(rhs.m_handle, {});
+        }
+        return *this;
+    }
+
+    ~generator() {
+        if (m_handle) { m_handle.destroy(); }
+    }
+
+    // runs the coroutine until the first value, call only once
+    iterator begin() {
+        advance(m_handle);
+        return iterator{m_handle};
+    }
+
+    std::default_sentinel_t end() const noexcept { return {}; }
+
+private:
+    explicit generator(std::coroutine_handle<promise_type> handle)
+        : m_handle(handle) {}
+
+    static void advance(std::coroutine_handle<promise_type> handle) {
+        handle.resume();
+        if (handle.promise().m_exception) {
+            std::rethrow_exception(handle.promise().m_exception);
+        }
+    }
+
+    std::coroutine_handle<promise_type> m_handle;
+};
+
+// what the streaming run() yields after each step, var is not copied
+template <typename VarType>
+struct StepView {
+    double t;
+    double dt;
+    const VarType &var;
+};
+}  // namespace flux
+
+// NOLINTEND(readability-identifier-naming)
@@ -0,0 +1,80 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <type_traits>
+
+namespace flux {
+
+// Explicit RK method with S stages in Williamson 2N form
+// G = A[i] * G + L(u)
+// u = u + dt * B[i] * G
+// only the state u and one register G are stored, A[0] must be 0.
+template <std::size_t S>
+struct LowStorageTableau {
+    std::array<double, S> A;
+    std::array<double, S> B;
+
+    static constexpr std::size_t stages() { return S; }
+
+    // time of the stage values, in units of dt (apply the method to u' = 1)
+    constexpr std::array<double, S + 1> c() const {
+        std::array<double, S + 1> result{};
+        double g = 0;
+        for (std::size_t i = 0; i < S; i++) {
+            g = A[i] * g + 1;
+            result[i + 1] = result[i] + B[i] * g;
+        }
+        return result;
+    }
+};
+
+template <typename T>
+struct IsLowStorageTableau : std::false_type {};
+
+template <std::size_t S>
+struct IsLowStorageTableau<LowStorageTableau<S>> : std::true_type {};
+
+template <typename T>
+concept LowStorageTableauType =
+    IsLowStorageTableau<std::remove_cv_t<T>>::value;
+
+namespace low_storage {
+
+// third order, Williamson (1980)
+inline constexpr LowStorageTableau<3> williamson33{
+    .A = {0, -5.0 / 9, -153.0 / 128},
+    .B = {1.0 / 3, 15.0 / 16, 8.0 / 15},
+};
+
+// fourth order, Carpenter and Kennedy (1994)
+inline constexpr LowStorageTableau<5> ck54{
+    .A = {0, -567301805773.0 / 1357537059087, -2404267990393.0 / 2016746695238,
+          -3550918686646.0 / 2091501179385, -1275806237668.0 / 842570457699},
+    .B = {1432997174477.0 / 9575080441755, 5161836677717.0 / 13612068292357,
+          1720146321549.0 / 2090206949498, 3134564353537.0 / 4481467310338,
+          2277821191437.0 / 14882151754819},
+};
+
+}  // namespace low_storage
+
+// One step of a 2N tableau, shared by all frameworks.
+// op_L_acc(var, G, a, t) sets G = a * G + L(var) (with a == 0 G is
+// overwritten), post_process_rk_stage(var, t) modifies the stage value,
+// t is the time of the latest op_L_acc evaluation.
+template <auto Tableau, typename VarType, typename OpAccType, typename StageType>
+    requires LowStorageTableauType<decltype(Tableau)>
+void low_storage_step(VarType &var, VarType &G, double t, double dt,
+                      const OpAccType &op_L_acc,
+                      const StageType &post_process_rk_stage) {
+    static_assert(Tableau.A[0] == 0, "A[0] of a 2N tableau must be 0");
+    constexpr auto c = Tableau.c();
+
+    for (std::size_t i = 0; i < Tableau.stages(); i++) {
+        op_L_acc(var, G, Tableau.A[i], t + c[i] * dt);
+        var += (Tableau.B[i] * dt) * G;
+
+        post_process_rk_stage(var, t + c[i] * dt);
+    }
+}
+}  // namespace flux
@@ -0,0 +1,97 @@
+#pragma once
+
+#include <concepts>
+#include <span>
+#include <type_traits>
+
+namespace flux {
+
+// Observers see the state as a read-only span, VarType provides it with a
+// free function as_span(const VarType &) found by ADL.
+template <typename T>
+concept SpanVarRequirements = requires(const T &var) {
+    { as_span(var) } -> std::convertible_to<std::span<const double>>;
+};
+
+// no observer attached, every notification is removed at compile time
+struct NullObserver {};
+
+// observer of the compile-time frameworks (CRTP, deducing, template), the
+// solvers are const, so an observer writes through a reference or pointer
+template <typename T>
+concept ObserverRequirements = requires(const T &observer,
+                                        std::span<const double> var, double t,
+                                        double dt) {
+    observer.pre_step(var, t, dt);
+    observer.post_stage(var, t, dt);
+    observer.post_step(var, t, dt);
+};
+
+// observer of the runtime frameworks (virtual, stdfunc), passed by pointer,
+// nullptr means no observer
+class ObserverBase {
+public:
+    // before pre_process, var is the state at t and dt the step to take (the
+    // first attempt for the adaptive solvers)
+    virtual void pre_step(std::span<const double> var, double t, double dt) {}
+
+    // after each post_process_rk_stage, t is the time passed to it; not called
+    // by the tiled and adaptive solvers
+    virtual void post_stage(std::span<const double> var, double t, double dt) {}
+
+    // after post_process, var is the new state at t
+    virtual void post_step(std::span<const double> var, double t, double dt) {}
+
+    virtual ~ObserverBase() = default;
+};
+
+template <typename T>
+concept ObserverTypeRequirements =
+    std::same_as<T, NullObserver> || ObserverRequirements<T>
+    || std::convertible_to<T, ObserverBase *>;
+
+namespace detail {
+
+template <typename ObserverType>
+constexpr bool is_null_observer_v =
+    std::same_as<std::remove_cvref_t<ObserverType>, NullObserver>;
+
+template <typename ObserverType>
+constexpr bool is_observer_pointer_v =
+    std::is_pointer_v<std::remove_cvref_t<ObserverType>>;
+
+}  // namespace detail
+
+template <typename ObserverType, typename VarType>
+void observe_pre_step(ObserverType &&observer, const VarType &var, double t,
+                      double dt) {
+    if constexpr (detail::is_observer_pointer_v<ObserverType>) {
+        if (observer != nullptr) { observer->pre_step(as_span(var), t, dt); }
+    }
+    else if constexpr (!detail::is_null_observer_v<ObserverType>) {
+        observer.pre_step(as_span(var), t, dt);
+    }
+}
+
+template <typename ObserverType, typename VarType>
+void observe_post_stage(ObserverType &&observer, const VarType &var, double t,
+                        double dt) {
+    if constexpr (detail::is_observer_pointer_v<ObserverType>) {
+        if (observer != nullptr) { observer->post_stage(as_span(var), t, dt); }
+    }
+    else if constexpr (!detail::is_null_observer_v<ObserverType>) {
+        observer.post_stage(as_span(var), t, dt);
+    }
+}
+
+template <typename ObserverType, typename VarType>
+void observe_post_step(ObserverType &&observer, const VarType &var, double t,
+                       double dt) {
+    if constexpr (detail::is_observer_pointer_v<ObserverType>) {
+        if (observer != nullptr) { observer->post_step(as_span(var), t, dt); }
+    }
+    else if constexpr (!detail::is_null_observer_v<ObserverType>) {
+        observer.post_step(as_span(var), t, dt);
+    }
+}
+}  // namespace flux
@@ -0,0 +1,146 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <concepts>
+#include <cstddef>
+#include <limits>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "adaptive.hpp"
+#include "expected.hpp"
+#include "parallel/thread_pool.hpp"
+#include "requires.h"
+
+namespace flux {
+
+// anything with the run() of the solvers, e.g. solver_template::Solver
+template <typename SolverType, typename VarType, typename ExType>
+concept PropagatorRequirements =
+    requires(const SolverType &solver, const VarType &var, ExType &ex,
+             double t) {
+        {
+            solver.run(var, ex, t, t)
+        } -> std::same_as<flux::expected<VarType, std::string>>;
+    };
+
+struct PararealOptions {
+    // time slices, the fine solver runs on all of them at once
+    std::size_t slices = 8;
+
+    // at most slices iterations are needed, the result is then the fine one
+    std::size_t max_iterations = std::numeric_limits<std::size_t>::max();
+
+    // stop when no slice end moved more than tol (max norm)
+    double tol = 1e-10;
+
+    // nullptr means ThreadPool::global()
+    ThreadPool *pool = nullptr;
+};
+
+struct PararealReport {
+    std::size_t iterations = 0;
+    double correction = 0;  // max norm of the last correction
+};
+
+namespace detail {
+template <IndexableVarRequirements VarType>
+double max_difference(const VarType &a, const VarType &b) {
+    double diff = 0;
+    for (std::size_t i = 0; i < a.size(); i++) {
+        diff = std::max(diff, std::abs(a[i] - b[i]));
+    }
+    return diff;
+}
+}  // namespace detail
+
+// Parareal (Lions, Maday, Turinici) on [t0, tend] split in options.slices
+// slices [T_j, T_j+1). The coarse solver G predicts the slice ends serially,
+// the fine solver F corrects them, running on all slices at once:
+//   U_j+1 = F(U_j^k) + G(U_j^k+1) - G(U_j^k)
+// After k iterations the first k slices equal the serial fine solution, so
+// the iteration stops after at most slices iterations, or when no slice end
+// moved more than options.tol.
+//
+// The fine runs of different slices are tasks of the pool and may spawn
+// their own parallel loops. Each one gets a copy of ex, the solvers must not
+// share other mutable state (e.g. an observer) between the slices.
+template <typename VarType, typename ExType, typename CoarseType,
+          typename FineType>
+    requires VarRequirements<VarType> && IndexableVarRequirements<VarType>
+             && std::copy_constructible<ExType>
+             && PropagatorRequirements<CoarseType, VarType, ExType>
+             && PropagatorRequirements<FineType, VarType, ExType>
+auto parareal(const CoarseType &coarse, const FineType &fine, VarType var,
+              ExType &ex, double t0, double tend,
+              const PararealOptions &options = {},
+              PararealReport *report = nullptr)
+    -> flux::expected<VarType, std::string> {
+    if (tend <= t0) return var;
+
+    std::size_t num_slices = std::max<std::size_t>(options.slices, 1);
+    auto time = [&](std::size_t j) {
+        if (j == num_slices) return tend;
+        return t0 + (tend - t0) * static_cast<double>(j)
+                        / static_cast<double>(num_slices);
+    };
+
+    // first prediction, U[j] is the state at time(j)
+    std::vector<VarType> U{var};
+    std::vector<VarType> G;
+    for (std::size_t j = 0; j < num_slices; j++) {
+        auto res = coarse.run(U[j], ex, time(j), time(j + 1));
+        if (!res.has_value()) return res;
+        G.push_back(res.value());
+        U.push_back(res.value());
+    }
+
+    ThreadPool &pool =
+        options.pool != nullptr ? *options.pool : ThreadPool::global();
+    std::size_t max_iterations = std::min(options.max_iterations, num_slices);
+    std::size_t k = 0;
+    double correction = 0;
+    while (k < max_iterations) {
+        // the slices before k are converged
+        auto F = std::vector<std::optional<VarType>>(num_slices);
+        auto errors = std::vector<std::string>(num_slices);
+        pool.run(num_slices - k, [&](std::size_t task) {
+            std::size_t j = k + task;
+            ExType ex_slice = ex;
+            auto res = fine.run(U[j], ex_slice, time(j), time(j + 1));
+            if (res.has_value()) {
+                F[j] = std::move(res.value());
+            } else {
+                errors[j] = std::move(res.error());
+            }
+        });
+        for (std::size_t j = k; j < num_slices; j++) {
+            if (!F[j]) return flux::unexpected{errors[j]};
+        }
+
+        // U[k] did not change, so U[k + 1] is the fine solution
+        correction = detail::max_difference(*F[k], U[k + 1]);
+        U[k + 1] = *F[k];
+        for (std::size_t j = k + 1; j < num_slices; j++) {
+            auto res = coarse.run(U[j], ex, time(j), time(j + 1));
+            if (!res.has_value()) return res;
+
+            // F + (G_new - G_old) is F exactly once U[j] is converged
+            VarType next = *F[j] + (res.value() - G[j]);
+            correction =
+                std::max(correction, detail::max_difference(next, U[j + 1]));
+            G[j] = res.value();
+            U[j + 1] = next;
+        }
+
+        k++;
+        if (correction <= options.tol) break;
+    }
+
+    if (report != nullptr) { *report = {k, correction}; }
+    return U[num_slices];
+}
+}  // namespace flux
@@ -1,7 +1,14 @@
 #pragma once
 
+#include <concepts>
+#include <cstddef>
+#include <memory>
+#include <span>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
+#include "profiler.hpp"
 #include "requires.h"
 
 namespace flux {
@@ -10,43 +17,159 @@ struct Mesh1d {
     double dx;
 };
 
-struct Vec {
-    std::vector<double> data;
+// Vec arithmetic builds lazy expressions, which are evaluated element by
+// element only when assigned to a Vec, so a linear combination like
+// a * u + b * (v + dt * w) is one fused loop without temporaries.
+struct VecExprTag {};
 
-    explicit Vec(std::vector<double> d) : data(std::move(d)) {}
+template <typename E>
+concept VecExpression = std::derived_from<std::remove_cvref_t<E>, VecExprTag>;
 
-    Vec(const Vec &rhs) = default;
+// lvalue operands are kept by reference, temporaries are moved into the node
+template <typename E>
+using VecOperand =
+    std::conditional_t<std::is_lvalue_reference_v<E>,
+                       const std::remove_reference_t<E> &, std::remove_cvref_t<E>>;
 
-    Vec &operator=(const Vec &rhs) = default;
+template <typename LType, typename RType, typename OpType>
+class VecBinaryExpr : public VecExprTag {
+public:
+    VecBinaryExpr(LType lhs, RType rhs)
+        : m_lhs(std::forward<LType>(lhs)), m_rhs(std::forward<RType>(rhs)) {}
 
-    Vec(Vec &&rhs) noexcept = default;
+    double operator[](size_t i) const { return OpType{}(m_lhs[i], m_rhs[i]); }
 
-    Vec &operator=(Vec &&rhs) noexcept = default;
+    size_t size() const { return m_lhs.size(); }
 
-    ~Vec() = default;
+private:
+    LType m_lhs;
+    RType m_rhs;
+};
+
+template <typename EType>
+class VecScaledExpr : public VecExprTag {
+public:
+    VecScaledExpr(double scalar, EType expr)
+        : m_scalar(scalar), m_expr(std::forward<EType>(expr)) {}
+
+    double operator[](size_t i) const { return m_scalar * m_expr[i]; }
+
+    size_t size() const { return m_expr.size(); }
+
+private:
+    double m_scalar;
+    EType m_expr;
+};
+
+struct VecPlus {
+    double operator()(double a, double b) const { return a + b; }
+};
+
+struct VecMinus {
+    double operator()(double a, double b) const { return a - b; }
+};
+
+// The storage allocator is a parameter, so large states can use e.g. the
+// FirstTouchAllocator of parallel/first_touch.hpp. Vec is the common case.
+template <typename Allocator>
+struct BasicVec : public VecExprTag {
+    using Storage = std::vector<double, Allocator>;
+
+    Storage data;
+
+    // with FLUX_PROFILE every buffer a Vec creates or adopts is counted
+    explicit BasicVec(Storage d) : data(std::move(d)) {
+        FLUX_COUNT_ALLOCATION();
+    }
+
+    // copies the values into the storage of the allocator
+    explicit BasicVec(const std::vector<double> &d)
+        requires(!std::same_as<Storage, std::vector<double>>)
+        : data(d.begin(), d.end()) {
+        FLUX_COUNT_ALLOCATION();
+    }
+
+    // evaluate an expression, intentionally implicit: Vec v = a + b;
+    template <VecExpression E>
+        requires(!std::same_as<std::remove_cvref_t<E>, BasicVec>)
+    BasicVec(const E &expr) : data(expr.size()) {  // NOLINT(google-explicit-constructor)
+        FLUX_COUNT_ALLOCATION();
+        for (size_t i = 0; i < data.size(); ++i) { data[i] = expr[i]; }
+    }
+
+    BasicVec(const BasicVec &rhs) : data(rhs.data) { FLUX_COUNT_ALLOCATION(); }
+
+    BasicVec &operator=(const BasicVec &rhs) {
+        if (data.capacity() < rhs.data.size()) { FLUX_COUNT_ALLOCATION(); }
+        data = rhs.data;
+        return *this;
+    }
+
+    BasicVec(BasicVec &&rhs) noexcept = default;
+
+    BasicVec &operator=(BasicVec &&rhs) noexcept = default;
+
+    ~BasicVec() = default;
+
+    // element-wise, so the expression may refer to *this (v = a * v + b)
+    template <VecExpression E>
+        requires(!std::same_as<std::remove_cvref_t<E>, BasicVec>)
+    BasicVec &operator=(const E &expr) {
+        if (expr.size() != data.size()) { return *this = BasicVec(expr); }
+        for (size_t i = 0; i < data.size(); ++i) { data[i] = expr[i]; }
+        return *this;
+    }
 
-    Vec operator+(const Vec &rhs) const {
-        Vec result(data);
-        for (size_t i = 0; i < data.size(); ++i) {
-            result.data[i] += rhs.data[i];
-        }
-        return result;
+    template <VecExpression E>
+    BasicVec &operator+=(const E &expr) {
+        for (size_t i = 0; i < data.size(); ++i) { data[i] += expr[i]; }
+        return *this;
     }
 
-    Vec operator-(const Vec &rhs) const {
-        Vec result(data);
-        for (size_t i = 0; i < data.size(); ++i) {
-            result.data[i] -= rhs.data[i];
-        }
-        return result;
+    template <VecExpression E>
+    BasicVec &operator-=(const E &expr) {
+        for (size_t i = 0; i < data.size(); ++i) { data[i] -= expr[i]; }
+        return *this;
     }
 
-    friend Vec operator*(double scalar, const Vec &vec) {
-        Vec result(vec);
-        for (auto &v : result.data) { v *= scalar; }
-        return result;
+    BasicVec &operator*=(double scalar) {
+        for (auto &v : data) { v *= scalar; }
+        return *this;
     }
+
+    double operator[](size_t i) const { return data[i]; }
+
+    double &operator[](size_t i) { return data[i]; }
+
+    size_t size() const { return data.size(); }
 };
 
+using Vec = BasicVec<std::allocator<double>>;
+
+template <VecExpression L, VecExpression R>
+auto operator+(L &&lhs, R &&rhs) {
+    return VecBinaryExpr<VecOperand<L>, VecOperand<R>, VecPlus>(
+        std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <VecExpression L, VecExpression R>
+auto operator-(L &&lhs, R &&rhs) {
+    return VecBinaryExpr<VecOperand<L>, VecOperand<R>, VecMinus>(
+        std::forward<L>(lhs), std::forward<R>(rhs));
+}
+
+template <VecExpression E>
+auto operator*(double scalar, E &&expr) {
+    return VecScaledExpr<VecOperand<E>>(scalar, std::forward<E>(expr));
+}
+
+// read-only view for observers, see observer.hpp
+template <typename Allocator>
+std::span<const double> as_span(const BasicVec<Allocator> &var) {
+    return var.data;
+}
+
 static_assert(VarRequirements<Vec>, "Vec does not satisfy VarRequirements!");
+static_assert(InplaceVarRequirements<Vec>,
+              "Vec does not satisfy InplaceVarRequirements!");
 }  // namespace flux
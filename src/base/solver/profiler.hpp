@@ -0,0 +1,197 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <sstream>
+#include <string>
+
+// Solver instrumentation, enabled by defining FLUX_PROFILE (cmake
+// -DFLUX_PROFILE=ON). Otherwise every macro below expands to its bare
+// expression and nothing is recorded.
+//
+// FLUX_TIMED(phase, expr)      evaluates expr and adds its wall time to phase
+// FLUX_TIMED_STEP(t, expr)     one step of run(), expr advances t
+// FLUX_COUNT_ALLOCATION()      a buffer of VarType or a solver scratch was
+//                              allocated
+#ifdef FLUX_PROFILE
+#define FLUX_TIMED(phase, ...)                                                 \
+    ::flux::profile::timed(::flux::profile::Phase::phase,                      \
+                           [&]() -> decltype(auto) { return __VA_ARGS__; })
+#define FLUX_TIMED_STEP(t, ...)                                                \
+    ::flux::profile::timed_step(t,                                             \
+                                [&]() -> decltype(auto) { return __VA_ARGS__; })
+#define FLUX_COUNT_ALLOCATION() ::flux::profile::report().add_allocation()
+#else
+#define FLUX_TIMED(phase, ...) (__VA_ARGS__)
+#define FLUX_TIMED_STEP(t, ...) (__VA_ARGS__)
+#define FLUX_COUNT_ALLOCATION() ((void)0)
+#endif
+
+namespace flux::profile {
+
+#ifdef FLUX_PROFILE
+inline constexpr bool enabled = true;
+#else
+inline constexpr bool enabled = false;
+#endif
+
+// callbacks of the updaters, update is the whole step
+enum class Phase : std::size_t {
+    get_dt = 0,
+    pre_process,
+    op_L,
+    post_process_rk_stage,
+    post_process,
+    update,
+};
+
+inline constexpr std::size_t phase_count = 6;
+
+inline constexpr std::array<const char *, phase_count> phase_names = {
+    "get_dt",       "pre_process", "op_L", "post_process_rk_stage",
+    "post_process", "update"};
+
+struct PhaseStats {
+    double seconds = 0;
+    std::uint64_t calls = 0;
+};
+
+// statistics of the current thread, see report()
+class Report {
+public:
+    void add_phase(Phase phase, double seconds) {
+        auto &stats = m_phases[static_cast<std::size_t>(phase)];
+        stats.seconds += seconds;
+        stats.calls++;
+    }
+
+    void add_step(double dt) {
+        m_steps++;
+        m_dt_min = std::min(m_dt_min, dt);
+        m_dt_max = std::max(m_dt_max, dt);
+        m_dt_sum += dt;
+        if (dt > 0) { m_dt_histogram[decade(dt)]++; }
+    }
+
+    void add_allocation() { m_allocations++; }
+
+    void reset() { *this = Report{}; }
+
+    const PhaseStats &phase(Phase phase) const {
+        return m_phases[static_cast<std::size_t>(phase)];
+    }
+
+    // time in update() outside the callbacks, i.e. the VarType arithmetic
+    double arithmetic_seconds() const {
+        double result = phase(Phase::update).seconds;
+        for (std::size_t i = 0; i < phase_count - 1; ++i) {
+            result -= m_phases[i].seconds;
+        }
+        return std::max(result, 0.0);
+    }
+
+    std::uint64_t steps() const { return m_steps; }
+
+    double dt_min() const { return m_steps > 0 ? m_dt_min : 0; }
+
+    double dt_max() const { return m_steps > 0 ? m_dt_max : 0; }
+
+    double dt_mean() const {
+        return m_steps > 0 ? m_dt_sum / static_cast<double>(m_steps) : 0;
+    }
+
+    // number of steps with dt in [10^k, 10^(k+1)), keyed by k
+    const std::map<int, std::uint64_t> &dt_histogram() const {
+        return m_dt_histogram;
+    }
+
+    std::uint64_t allocations() const { return m_allocations; }
+
+    std::string to_json() const {
+        std::ostringstream os;
+        os.precision(17);
+        os << "{\n  \"enabled\": " << (enabled ? "true" : "false") << ",\n";
+        os << "  \"phases\": {\n";
+        for (std::size_t i = 0; i < phase_count; ++i) {
+            os << "    \"" << phase_names[i] << "\": {\"seconds\": "
+               << m_phases[i].seconds << ", \"calls\": " << m_phases[i].calls
+               << "},\n";
+        }
+        os << "    \"arithmetic\": {\"seconds\": " << arithmetic_seconds()
+           << "}\n  },\n";
+        os << "  \"steps\": " << m_steps << ",\n";
+        os << "  \"dt\": {\"min\": " << dt_min() << ", \"max\": " << dt_max()
+           << ", \"mean\": " << dt_mean() << ", \"histogram\": [";
+        bool first = true;
+        for (const auto &[k, count] : m_dt_histogram) {
+            if (!first) { os << ", "; }
+            os << "{\"decade\": " << k << ", \"count\": " << count << "}";
+            first = false;
+        }
+        os << "]},\n";
+        os << "  \"allocations\": " << m_allocations << "\n}\n";
+        return os.str();
+    }
+
+private:
+    std::array<PhaseStats, phase_count> m_phases{};
+    std::uint64_t m_steps = 0;
+    double m_dt_min = std::numeric_limits<double>::max();
+    double m_dt_max = 0;
+    double m_dt_sum = 0;
+    std::map<int, std::uint64_t> m_dt_histogram;
+    std::uint64_t m_allocations = 0;
+
+    static int decade(double dt) {
+        return static_cast<int>(std::floor(std::log10(dt)));
+    }
+};
+
+// one report per thread, so the counters need no synchronization
+inline Report &report() {
+    thread_local Report instance;
+    return instance;
+}
+
+using Clock = std::chrono::steady_clock;
+
+inline double seconds_since(Clock::time_point start) {
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+template <typename Func>
+decltype(auto) timed(Phase phase, Func &&func) {
+    // the guard also records calls which throw
+    struct Guard {
+        Phase phase;
+        Clock::time_point start;
+
+        ~Guard() { report().add_phase(phase, seconds_since(start)); }
+    } guard{phase, Clock::now()};
+
+    return func();
+}
+
+template <typename Func>
+decltype(auto) timed_step(const double &t, Func &&func) {
+    struct Guard {
+        const double &t;
+        double t_old;
+        Clock::time_point start;
+
+        ~Guard() {
+            report().add_phase(Phase::update, seconds_since(start));
+            report().add_step(t - t_old);
+        }
+    } guard{t, t, Clock::now()};
+
+    return func();
+}
+
+}  // namespace flux::profile
@@ -8,3 +8,12 @@ concept VarRequirements = requires(T a, T b, double d) {
     a = b;
     T(a);
 };
+
+// extra requirements of the in-place updaters, which never create temporaries
+template <typename T>
+concept InplaceVarRequirements =
+    VarRequirements<T> && requires(T a, T b, double d) {
+        a += b;
+        a -= b;
+        a *= d;
+    };
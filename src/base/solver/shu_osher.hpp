@@ -0,0 +1,236 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <optional>
+#include <type_traits>
+#include <utility>
+
+namespace flux {
+
+// Explicit RK method with S stages in Shu-Osher form
+// u^(0) = u^n
+// u^(i) = sum_{k<i} alpha[i-1][k] * u^(k) + dt * beta[i-1][k] * L(u^(k))
+// u^{n+1} = u^(S)
+// used as a template argument, so every stage is unrolled at compile time.
+template <std::size_t S>
+struct ShuOsherTableau {
+    std::array<std::array<double, S>, S> alpha;
+    std::array<std::array<double, S>, S> beta;
+
+    static constexpr std::size_t stages() { return S; }
+
+    // time of u^(i), in units of dt
+    constexpr double c(std::size_t i) const {
+        if (i == 0) return 0;
+
+        double result = 0;
+        for (std::size_t k = 0; k < i; k++) {
+            result += alpha[i - 1][k] * c(k) + beta[i - 1][k];
+        }
+        return result;
+    }
+};
+
+template <typename T>
+struct IsShuOsherTableau : std::false_type {};
+
+template <std::size_t S>
+struct IsShuOsherTableau<ShuOsherTableau<S>> : std::true_type {};
+
+template <typename T>
+concept ShuOsherTableauType = IsShuOsherTableau<std::remove_cv_t<T>>::value;
+
+// presets, the SSP coefficient C allows dt <= C * dt_euler
+namespace shu_osher {
+
+// forward Euler, C = 1
+inline constexpr ShuOsherTableau<1> euler{
+    .alpha = {{{1}}},
+    .beta = {{{1}}},
+};
+
+// SSPRK(3,3) of Shu and Osher, C = 1
+inline constexpr ShuOsherTableau<3> ssprk33{
+    .alpha = {{
+        {1, 0, 0},
+        {3.0 / 4, 1.0 / 4, 0},
+        {1.0 / 3, 0, 2.0 / 3},
+    }},
+    .beta = {{
+        {1, 0, 0},
+        {0, 1.0 / 4, 0},
+        {0, 0, 2.0 / 3},
+    }},
+};
+
+// SSPRK(5,4) of Spiteri and Ruuth, C = 1.508
+inline constexpr ShuOsherTableau<5> ssprk54{
+    .alpha = {{
+        {1, 0, 0, 0, 0},
+        {0.444370493651235, 0.555629506348765, 0, 0, 0},
+        {0.620101851488403, 0, 0.379898148511597, 0, 0},
+        {0.178079954393132, 0, 0, 0.821920045606868, 0},
+        {0, 0, 0.517231671970585, 0.096059710526147, 0.386708617503269},
+    }},
+    .beta = {{
+        {0.391752226571890, 0, 0, 0, 0},
+        {0, 0.368410593050371, 0, 0, 0},
+        {0, 0, 0.251891774271694, 0, 0},
+        {0, 0, 0, 0.544974750228521, 0},
+        {0, 0, 0, 0.063692468666290, 0.226007483236906},
+    }},
+};
+
+// SSPRK(10,4) of Ketcheson, C = 6
+inline constexpr ShuOsherTableau<10> ssprk104{
+    .alpha = {{
+        {1, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 1, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 1, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 1, 0, 0, 0, 0, 0, 0},
+        {3.0 / 5, 0, 0, 0, 2.0 / 5, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 1, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 1, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 1, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 1, 0},
+        {1.0 / 25, 0, 0, 0, 9.0 / 25, 0, 0, 0, 0, 3.0 / 5},
+    }},
+    .beta = {{
+        {1.0 / 6, 0, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 1.0 / 6, 0, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 1.0 / 6, 0, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 1.0 / 6, 0, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 1.0 / 15, 0, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 1.0 / 6, 0, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 1.0 / 6, 0, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 1.0 / 6, 0, 0},
+        {0, 0, 0, 0, 0, 0, 0, 0, 1.0 / 6, 0},
+        {0, 0, 0, 0, 3.0 / 50, 0, 0, 0, 0, 1.0 / 10},
+    }},
+};
+
+// classical RK4, not SSP
+inline constexpr ShuOsherTableau<4> rk4{
+    .alpha = {{
+        {1, 0, 0, 0},
+        {1, 0, 0, 0},
+        {1, 0, 0, 0},
+        {1, 0, 0, 0},
+    }},
+    .beta = {{
+        {1.0 / 2, 0, 0, 0},
+        {0, 1.0 / 2, 0, 0},
+        {0, 0, 1, 0},
+        {1.0 / 6, 1.0 / 3, 1.0 / 3, 1.0 / 6},
+    }},
+};
+
+}  // namespace shu_osher
+
+namespace detail {
+
+// number of nonzero terms (alpha or beta) in row i
+template <auto Tableau, std::size_t I>
+consteval std::size_t shu_osher_term_num() {
+    std::size_t num = 0;
+    for (std::size_t k = 0; k <= I; k++) {
+        if (Tableau.alpha[I][k] != 0 || Tableau.beta[I][k] != 0) num++;
+    }
+    return num;
+}
+
+// columns of the nonzero terms in row i
+template <auto Tableau, std::size_t I>
+consteval auto shu_osher_terms() {
+    std::array<std::size_t, shu_osher_term_num<Tableau, I>()> result{};
+    std::size_t num = 0;
+    for (std::size_t k = 0; k <= I; k++) {
+        if (Tableau.alpha[I][k] != 0 || Tableau.beta[I][k] != 0) {
+            result[num++] = k;
+        }
+    }
+    return result;
+}
+
+template <auto Tableau, std::size_t I>
+inline constexpr auto shu_osher_terms_v = shu_osher_terms<Tableau, I>();
+
+// last row which reads u^(k) (or L(u^(k)) if use_beta)
+template <auto Tableau, std::size_t K>
+consteval std::size_t shu_osher_last_use(bool use_beta) {
+    std::size_t last = K;
+    for (std::size_t i = K; i < Tableau.stages(); i++) {
+        const auto &coef = use_beta ? Tableau.beta : Tableau.alpha;
+        if (coef[i][K] != 0) last = i;
+    }
+    return last;
+}
+
+}  // namespace detail
+
+// One step of a Shu-Osher tableau, shared by all frameworks.
+// op_L(var, t) returns L(var), post_process_rk_stage(var, t) returns the
+// processed stage value, t is the time of the latest op_L evaluation.
+// Each stage is one (fused) linear combination, stage values are released
+// after their last use.
+template <auto Tableau, typename VarType, typename OpType, typename StageType>
+    requires ShuOsherTableauType<decltype(Tableau)>
+VarType shu_osher_step(const VarType &var_n, double t, double dt,
+                       const OpType &op_L,
+                       const StageType &post_process_rk_stage) {
+    constexpr std::size_t S = Tableau.stages();
+
+    std::array<std::optional<VarType>, S + 1> u;  // u[0] is unused, var_n
+    std::array<std::optional<VarType>, S> L;
+
+    auto stage_value = [&]<std::size_t K>() -> const VarType & {
+        if constexpr (K == 0) { return var_n; }
+        else { return *u[K]; }
+    };
+
+    auto term = [&]<std::size_t I, std::size_t K>() {
+        constexpr double a = Tableau.alpha[I][K];
+        constexpr double b = Tableau.beta[I][K];
+        if constexpr (b == 0) { return a * stage_value.template operator()<K>(); }
+        else if constexpr (a == 0) { return (b * dt) * (*L[K]); }
+        else {
+            return a * stage_value.template operator()<K>() + (b * dt) * (*L[K]);
+        }
+    };
+
+    auto release = [&]<std::size_t I, std::size_t K>() {
+        if constexpr (K > 0
+                      && detail::shu_osher_last_use<Tableau, K>(false) == I) {
+            u[K].reset();
+        }
+        if constexpr (detail::shu_osher_last_use<Tableau, K>(true) == I) {
+            L[K].reset();
+        }
+    };
+
+    auto stage = [&]<std::size_t I>() {
+        constexpr double ci = Tableau.c(I);
+        L[I].emplace(op_L(stage_value.template operator()<I>(), t + ci * dt));
+
+        constexpr auto &terms = detail::shu_osher_terms_v<Tableau, I>;
+        [&]<std::size_t... J>(std::index_sequence<J...>) {
+            u[I + 1].emplace((term.template operator()<
+                                  I, detail::shu_osher_terms_v<Tableau, I>[J]>()
+                              + ...));
+        }(std::make_index_sequence<terms.size()>{});
+
+        *u[I + 1] = post_process_rk_stage(*u[I + 1], t + ci * dt);
+
+        [&]<std::size_t... K>(std::index_sequence<K...>) {
+            (release.template operator()<I, K>(), ...);
+        }(std::make_index_sequence<I + 1>{});
+    };
+
+    [&]<std::size_t... I>(std::index_sequence<I...>) {
+        (stage.template operator()<I>(), ...);
+    }(std::make_index_sequence<S>{});
+
+    return std::move(*u[S]);
+}
+}  // namespace flux
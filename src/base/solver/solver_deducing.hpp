@@ -1,10 +1,20 @@
 #pragma once
 
+#include <algorithm>
 #include <limits>
 #include <string>
 
+#include "adaptive.hpp"
+#include "dense_output.hpp"
 #include "expected.hpp"
+#include "generator.hpp"
+#include "low_storage.hpp"
+#include "observer.hpp"
+#include "profiler.hpp"
 #include "requires.h"
+#include "shu_osher.hpp"
+#include "stage_buffers.hpp"
+#include "tiled.hpp"
 
 namespace flux::solver_deducing {
 
@@ -15,16 +25,32 @@ public:
              double tend) -> flux::expected<VarType, std::string> {
         if (tend <= t0) return var;
 
-        double t = 0;
+        double t = t0;
         bool stop_flag = false;
         constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
         for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
-            var = self.update(var, ex, t, stop_flag, tend);
+            var = FLUX_TIMED_STEP(t, self.update(var, ex, t, stop_flag, tend));
         }
         if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
 
         return var;
     }
+
+    // run() as a lazy sequence of steps, each step yields (t, dt, var) without
+    // copying var; the solver and ex must outlive the generator.
+    auto stream(this const auto &self, VarType var, ExType &ex, double t0,
+                double tend) -> generator<StepView<VarType>> {
+        if (tend <= t0) co_return;
+
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            double t_old = t;
+            var = FLUX_TIMED_STEP(t, self.update(var, ex, t, stop_flag, tend));
+            co_yield StepView<VarType>{t, t - t_old, var};
+        }
+    }
 };
 
 template <VarRequirements VarType, typename ExType>
@@ -32,17 +58,21 @@ class EulerSolver : public Solver<VarType, ExType> {
 public:
     VarType update(this const auto &self, const VarType &var, ExType &ex,
                    double &t, bool &stop_flag, double tend) {
-        double dt = self.get_dt(var, ex, t);
+        double dt = FLUX_TIMED(get_dt, self.get_dt(var, ex, t));
         if (t + dt >= tend && t < tend) {
             dt = tend - t;
             stop_flag = true;
         }
 
-        auto var_n = self.pre_process(var, ex, t);
+        observe_pre_step(self.observer(), var, t, dt);
 
-        VarType var2 = var_n + dt * self.op_L(var_n, ex, t);
+        auto var_n = FLUX_TIMED(pre_process, self.pre_process(var, ex, t));
 
-        var2 = self.post_process(var2, ex, t);
+        VarType var2 = var_n + dt * FLUX_TIMED(op_L, self.op_L(var_n, ex, t));
+
+        var2 = FLUX_TIMED(post_process, self.post_process(var2, ex, t));
+
+        observe_post_step(self.observer(), var2, t + dt, dt);
 
         t += dt;
         return var2;
@@ -55,6 +85,9 @@ public:
     VarType pre_process(const VarType &var, ExType &ex, double t) const {
         return var;
     }
+
+    // no observer by default, see observer.hpp
+    NullObserver observer() const { return {}; }
 };
 
 template <VarRequirements VarType, typename ExType>
@@ -62,35 +95,458 @@ class RK3Solver : public Solver<VarType, ExType> {
 public:
     VarType update(this const auto &self, const VarType &var, ExType &ex,
                    double &t, bool &stop_flag, double tend) {
-        double dt = self.get_dt(var, ex, t);
+        double dt = FLUX_TIMED(get_dt, self.get_dt(var, ex, t));
         if (t + dt >= tend && t < tend) {
             dt = tend - t;
             stop_flag = true;
         }
 
-        auto var_n = self.pre_process(var, ex, t);
+        observe_pre_step(self.observer(), var, t, dt);
+
+        auto var_n = FLUX_TIMED(pre_process, self.pre_process(var, ex, t));
 
-        VarType var1 = var_n + dt * self.op_L(var_n, ex, t);
+        VarType var1 = var_n + dt * FLUX_TIMED(op_L, self.op_L(var_n, ex, t));
 
-        var1 = self.post_process_rk_stage(var1, ex, t);
+        var1 = FLUX_TIMED(post_process_rk_stage,
+                          self.post_process_rk_stage(var1, ex, t));
+        observe_post_stage(self.observer(), var1, t, dt);
 
-        VarType var2 = (3.0 / 4) * var_n
-                       + (1.0 / 4) * (var1 + dt * self.op_L(var1, ex, t + dt));
+        auto k = FLUX_TIMED(op_L, self.op_L(var1, ex, t + dt));
+        VarType var2 = (3.0 / 4) * var_n + (1.0 / 4) * (var1 + dt * k);
 
-        var2 = self.post_process_rk_stage(var2, ex, t + dt);
+        var2 = FLUX_TIMED(post_process_rk_stage,
+                          self.post_process_rk_stage(var2, ex, t + dt));
+        observe_post_stage(self.observer(), var2, t + dt, dt);
 
-        VarType var3 =
-            (1.0 / 3) * var_n
-            + (2.0 / 3) * (var2 + dt * self.op_L(var2, ex, t + dt / 2));
+        k = FLUX_TIMED(op_L, self.op_L(var2, ex, t + dt / 2));
+        VarType var3 = (1.0 / 3) * var_n + (2.0 / 3) * (var2 + dt * k);
 
-        var3 = self.post_process_rk_stage(var3, ex, t + dt / 2);
+        var3 = FLUX_TIMED(post_process_rk_stage,
+                          self.post_process_rk_stage(var3, ex, t + dt / 2));
+        observe_post_stage(self.observer(), var3, t + dt / 2, dt);
 
-        var3 = self.post_process(var3, ex, t + dt);
+        var3 = FLUX_TIMED(post_process, self.post_process(var3, ex, t + dt));
+
+        observe_post_step(self.observer(), var3, t + dt, dt);
 
         t += dt;
         return var3;
     }
 
+    VarType update_dense(this const auto &self, const VarType &var,
+                         ExType &ex, double &t, bool &stop_flag, double tend,
+                         DenseOutput<VarType> &dense) {
+        double dt = FLUX_TIMED(get_dt, self.get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(self.observer(), var, t, dt);
+
+        auto var_n = FLUX_TIMED(pre_process, self.pre_process(var, ex, t));
+
+        VarType var3 = ssprk3_dense_step(
+            var_n, t, dt,
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(op_L, self.op_L(v, ex, s));
+            },
+            [&](const VarType &v, double s) {
+                VarType w = FLUX_TIMED(post_process_rk_stage,
+                                       self.post_process_rk_stage(v, ex, s));
+                observe_post_stage(self.observer(), w, s, dt);
+                return w;
+            },
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(post_process, self.post_process(v, ex, s));
+            },
+            dense);
+
+        observe_post_step(self.observer(), var3, t + dt, dt);
+
+        t += dt;
+        return var3;
+    }
+
+    // run() which also reports the state at the output times of dense
+    auto run_dense(this const auto &self, VarType var, ExType &ex, double t0,
+                   double tend, DenseOutput<VarType> &dense)
+        -> flux::expected<VarType, std::string> {
+        if (tend <= t0) return var;
+
+        double t = t0;
+        bool stop_flag = false;
+        dense.start(var, t0);
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            var = FLUX_TIMED_STEP(
+                t, self.update_dense(var, ex, t, stop_flag, tend, dense));
+        }
+        if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
+
+        return var;
+    }
+
+    VarType post_process(const VarType &var, ExType &ex, double t) const {
+        return var;
+    }
+
+    VarType pre_process(const VarType &var, ExType &ex, double t) const {
+        return var;
+    }
+
+    VarType post_process_rk_stage(const VarType &var, ExType &ex,
+                                  double t) const {
+        return var;
+    }
+
+    // no observer by default, see observer.hpp
+    NullObserver observer() const { return {}; }
+};
+
+// RK method given by a Shu-Osher tableau, see shu_osher.hpp
+template <VarRequirements VarType, typename ExType, auto Tableau>
+    requires ShuOsherTableauType<decltype(Tableau)>
+class RKSolver : public Solver<VarType, ExType> {
+public:
+    VarType update(this const auto &self, const VarType &var, ExType &ex,
+                   double &t, bool &stop_flag, double tend) {
+        double dt = FLUX_TIMED(get_dt, self.get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(self.observer(), var, t, dt);
+
+        auto var_n = FLUX_TIMED(pre_process, self.pre_process(var, ex, t));
+
+        VarType var2 = shu_osher_step<Tableau>(
+            var_n, t, dt,
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(op_L, self.op_L(v, ex, s));
+            },
+            [&](const VarType &v, double s) {
+                VarType w = FLUX_TIMED(post_process_rk_stage,
+                                       self.post_process_rk_stage(v, ex, s));
+                observe_post_stage(self.observer(), w, s, dt);
+                return w;
+            });
+
+        var2 = FLUX_TIMED(post_process, self.post_process(var2, ex, t + dt));
+
+        observe_post_step(self.observer(), var2, t + dt, dt);
+
+        t += dt;
+        return var2;
+    }
+
+    VarType post_process(const VarType &var, ExType &ex, double t) const {
+        return var;
+    }
+
+    VarType pre_process(const VarType &var, ExType &ex, double t) const {
+        return var;
+    }
+
+    VarType post_process_rk_stage(const VarType &var, ExType &ex,
+                                  double t) const {
+        return var;
+    }
+
+    // no observer by default, see observer.hpp
+    NullObserver observer() const { return {}; }
+};
+
+// In-place contract: op_L(var, out, ex, t) writes L(var) into out, the
+// processing hooks modify var directly, and the stage buffers are owned by
+// run(), so no state is allocated after the first step.
+template <InplaceVarRequirements VarType, typename ExType>
+class InplaceSolver {
+public:
+    auto run(this const auto &self, VarType var, ExType &ex, double t0,
+             double tend) -> flux::expected<VarType, std::string> {
+        if (tend <= t0) return var;
+
+        StageBuffers<VarType> buffers;
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            FLUX_TIMED_STEP(
+                t, self.update(var, buffers, ex, t, stop_flag, tend));
+        }
+        if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
+
+        return var;
+    }
+
+    // run() as a lazy sequence of steps, each step yields (t, dt, var) without
+    // copying var; the solver and ex must outlive the generator.
+    auto stream(this const auto &self, VarType var, ExType &ex, double t0,
+                double tend) -> generator<StepView<VarType>> {
+        if (tend <= t0) co_return;
+
+        StageBuffers<VarType> buffers;
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            double t_old = t;
+            FLUX_TIMED_STEP(
+                t, self.update(var, buffers, ex, t, stop_flag, tend));
+            co_yield StepView<VarType>{t, t - t_old, var};
+        }
+    }
+};
+
+template <InplaceVarRequirements VarType, typename ExType>
+class EulerInplaceSolver : public InplaceSolver<VarType, ExType> {
+public:
+    void update(this const auto &self, VarType &var,
+                StageBuffers<VarType> &buffers, ExType &ex, double &t,
+                bool &stop_flag, double tend) {
+        double dt = FLUX_TIMED(get_dt, self.get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(self.observer(), var, t, dt);
+
+        FLUX_TIMED(pre_process, self.pre_process(var, ex, t));
+
+        auto &k = buffers.get(0, var);
+        FLUX_TIMED(op_L, self.op_L(var, k, ex, t));
+        var += dt * k;
+
+        FLUX_TIMED(post_process, self.post_process(var, ex, t));
+
+        observe_post_step(self.observer(), var, t + dt, dt);
+
+        t += dt;
+    }
+
+    void post_process(VarType &var, ExType &ex, double t) const {}
+
+    void pre_process(VarType &var, ExType &ex, double t) const {}
+
+    // no observer by default, see observer.hpp
+    NullObserver observer() const { return {}; }
+};
+
+template <InplaceVarRequirements VarType, typename ExType>
+class RK3InplaceSolver : public InplaceSolver<VarType, ExType> {
+public:
+    void update(this const auto &self, VarType &var,
+                StageBuffers<VarType> &buffers, ExType &ex, double &t,
+                bool &stop_flag, double tend) {
+        double dt = FLUX_TIMED(get_dt, self.get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(self.observer(), var, t, dt);
+
+        FLUX_TIMED(pre_process, self.pre_process(var, ex, t));
+
+        auto &var_n = buffers.get(0, var);
+        auto &k = buffers.get(1, var);
+        var_n = var;
+
+        FLUX_TIMED(op_L, self.op_L(var_n, k, ex, t));
+        var += dt * k;
+
+        FLUX_TIMED(post_process_rk_stage,
+                   self.post_process_rk_stage(var, ex, t));
+        observe_post_stage(self.observer(), var, t, dt);
+
+        FLUX_TIMED(op_L, self.op_L(var, k, ex, t + dt));
+        var = (3.0 / 4) * var_n + (1.0 / 4) * (var + dt * k);
+
+        FLUX_TIMED(post_process_rk_stage,
+                   self.post_process_rk_stage(var, ex, t + dt));
+        observe_post_stage(self.observer(), var, t + dt, dt);
+
+        FLUX_TIMED(op_L, self.op_L(var, k, ex, t + dt / 2));
+        var = (1.0 / 3) * var_n + (2.0 / 3) * (var + dt * k);
+
+        FLUX_TIMED(post_process_rk_stage,
+                   self.post_process_rk_stage(var, ex, t + dt / 2));
+        observe_post_stage(self.observer(), var, t + dt / 2, dt);
+
+        FLUX_TIMED(post_process, self.post_process(var, ex, t + dt));
+
+        observe_post_step(self.observer(), var, t + dt, dt);
+
+        t += dt;
+    }
+
+    void post_process(VarType &var, ExType &ex, double t) const {}
+
+    void pre_process(VarType &var, ExType &ex, double t) const {}
+
+    void post_process_rk_stage(VarType &var, ExType &ex, double t) const {}
+
+    // no observer by default, see observer.hpp
+    NullObserver observer() const { return {}; }
+};
+
+// Tiled SSP-RK3, see tiled.hpp. op_L_tile(u, out, ex, t) writes L at
+// u[r + i] into out[i], r = tile_options().radius. The tiles run on several
+// threads at once, so op_L_tile gets ex as const. All stages of a tile run
+// at once, so there is no post_process_rk_stage and no stage observer.
+template <InplaceVarRequirements VarType, typename ExType>
+    requires TileableVarRequirements<VarType>
+class TiledRK3Solver : public InplaceSolver<VarType, ExType> {
+public:
+    void update(this const auto &self, VarType &var,
+                StageBuffers<VarType> &buffers, ExType &ex, double &t,
+                bool &stop_flag, double tend) {
+        double dt = FLUX_TIMED(get_dt, self.get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(self.observer(), var, t, dt);
+
+        FLUX_TIMED(pre_process, self.pre_process(var, ex, t));
+
+        const ExType &tile_ex = ex;
+        FLUX_TIMED(op_L, tiled_ssprk3_update(
+                             var, buffers, t, dt, self.tile_options(),
+                             [&](std::span<const double> u,
+                                 std::span<double> out, double s) {
+                                 self.op_L_tile(u, out, tile_ex, s);
+                             }));
+
+        FLUX_TIMED(post_process, self.post_process(var, ex, t + dt));
+
+        observe_post_step(self.observer(), var, t + dt, dt);
+
+        t += dt;
+    }
+
+    void post_process(VarType &var, ExType &ex, double t) const {}
+
+    void pre_process(VarType &var, ExType &ex, double t) const {}
+
+    TileOptions tile_options() const { return {}; }
+
+    // no observer by default, see observer.hpp
+    NullObserver observer() const { return {}; }
+};
+
+// 2N low-storage RK, see low_storage.hpp, only var and one buffer are used.
+// op_L_acc(var, out, a, ex, t) sets out = a * out + L(var).
+template <InplaceVarRequirements VarType, typename ExType, auto Tableau>
+    requires LowStorageTableauType<decltype(Tableau)>
+class LowStorageSolver : public InplaceSolver<VarType, ExType> {
+public:
+    void update(this const auto &self, VarType &var,
+                StageBuffers<VarType> &buffers, ExType &ex, double &t,
+                bool &stop_flag, double tend) {
+        double dt = FLUX_TIMED(get_dt, self.get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(self.observer(), var, t, dt);
+
+        FLUX_TIMED(pre_process, self.pre_process(var, ex, t));
+
+        auto &G = buffers.get(0, var);
+        low_storage_step<Tableau>(
+            var, G, t, dt,
+            [&](const VarType &v, VarType &out, double a, double s) {
+                FLUX_TIMED(op_L, self.op_L_acc(v, out, a, ex, s));
+            },
+            [&](VarType &v, double s) {
+                FLUX_TIMED(post_process_rk_stage,
+                           self.post_process_rk_stage(v, ex, s));
+                observe_post_stage(self.observer(), v, s, dt);
+            });
+
+        FLUX_TIMED(post_process, self.post_process(var, ex, t + dt));
+
+        observe_post_step(self.observer(), var, t + dt, dt);
+
+        t += dt;
+    }
+
+    void post_process(VarType &var, ExType &ex, double t) const {}
+
+    void pre_process(VarType &var, ExType &ex, double t) const {}
+
+    void post_process_rk_stage(VarType &var, ExType &ex, double t) const {}
+
+    // no observer by default, see observer.hpp
+    NullObserver observer() const { return {}; }
+};
+
+// Adaptive contract: update(var, controller, ex, t, stop_flag, tend) takes
+// one accepted step of the size proposed by the controller, which is owned
+// by run(). get_dt is the first dt and, with cfl_limit, an upper bound.
+template <VarRequirements VarType, typename ExType>
+class AdaptiveSolver {
+public:
+    auto run(this const auto &self, VarType var, ExType &ex, double t0,
+             double tend) -> flux::expected<VarType, std::string> {
+        if (tend <= t0) return var;
+
+        AdaptiveController controller{self.adaptive_options()};
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            var = FLUX_TIMED_STEP(
+                t, self.update(var, controller, ex, t, stop_flag, tend));
+        }
+        if (controller.failed()) { return flux::unexpected{std::string{"Step size too small"}}; }
+        if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
+
+        return var;
+    }
+
+    AdaptiveOptions adaptive_options() const { return {}; }
+};
+
+// SSPRK(3,3) with an embedded second order solution, see adaptive.hpp
+template <VarRequirements VarType, typename ExType>
+    requires IndexableVarRequirements<VarType>
+class AdaptiveRK3Solver : public AdaptiveSolver<VarType, ExType> {
+public:
+    VarType update(this const auto &self, const VarType &var,
+                   AdaptiveController &controller, ExType &ex, double &t,
+                   bool &stop_flag, double tend) {
+        double dt_max = FLUX_TIMED(get_dt, self.get_dt(var, ex, t));
+
+        // dt of the first attempt, post_step gets the dt of the accepted one
+        observe_pre_step(self.observer(), var, t,
+                         std::min(controller.next_dt(dt_max), tend - t));
+
+        auto var_n = FLUX_TIMED(pre_process, self.pre_process(var, ex, t));
+
+        VarType var2 = adaptive_rk32_step(
+            var_n, controller, t, stop_flag, tend, dt_max,
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(op_L, self.op_L(v, ex, s));
+            },
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(post_process_rk_stage,
+                                  self.post_process_rk_stage(v, ex, s));
+            });
+        if (controller.failed()) return var2;
+
+        var2 = FLUX_TIMED(post_process, self.post_process(var2, ex, t));
+
+        observe_post_step(self.observer(), var2, t, controller.last_dt());
+        return var2;
+    }
+
     VarType post_process(const VarType &var, ExType &ex, double t) const {
         return var;
     }
@@ -103,5 +559,8 @@ public:
                                   double t) const {
         return var;
     }
+
+    // no observer by default, see observer.hpp
+    NullObserver observer() const { return {}; }
 };
 }  // namespace flux::solver_deducing
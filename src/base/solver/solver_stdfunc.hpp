@@ -1,11 +1,21 @@
 #pragma once
 
+#include <algorithm>
 #include <functional>
 #include <limits>
 #include <string>
 
+#include "adaptive.hpp"
+#include "dense_output.hpp"
 #include "expected.hpp"
+#include "generator.hpp"
+#include "low_storage.hpp"
+#include "observer.hpp"
+#include "profiler.hpp"
 #include "requires.h"
+#include "shu_osher.hpp"
+#include "stage_buffers.hpp"
+#include "tiled.hpp"
 
 namespace flux::solver_stdfunc {
 
@@ -15,11 +25,21 @@ public:
     using UpdateFunc = std::function<VarType(const VarType &, ExType &,
                                              double &, bool &, double)>;
 
+    // update which also records the step into a dense output
+    using DenseUpdateFunc =
+        std::function<VarType(const VarType &, ExType &, double &, bool &,
+                              double, DenseOutput<VarType> &)>;
+
     Solver &set_update(UpdateFunc update) {
         m_update = update;
         return *this;
     }
 
+    Solver &set_dense_update(DenseUpdateFunc update) {
+        m_dense_update = update;
+        return *this;
+    }
+
     auto run(VarType var, ExType &ex, double t0,
              double tend) const -> flux::expected<VarType, std::string> {
         if (m_update == nullptr) {
@@ -28,11 +48,53 @@ public:
 
         if (tend <= t0) return var;
 
-        double t = 0;
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            var = FLUX_TIMED_STEP(t, m_update(var, ex, t, stop_flag, tend));
+        }
+        if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
+
+        return var;
+    }
+
+    // run() as a lazy sequence of steps, each step yields (t, dt, var) without
+    // copying var; the solver and ex must outlive the generator.
+    auto stream(VarType var, ExType &ex, double t0, double tend) const
+        -> generator<StepView<VarType>> {
+        if (m_update == nullptr) { co_return; }
+
+        if (tend <= t0) co_return;
+
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            double t_old = t;
+            var = FLUX_TIMED_STEP(t, m_update(var, ex, t, stop_flag, tend));
+            co_yield StepView<VarType>{t, t - t_old, var};
+        }
+    }
+
+    // run() which also reports the state at the output times of dense
+    auto run_dense(VarType var, ExType &ex, double t0, double tend,
+                   DenseOutput<VarType> &dense) const
+        -> flux::expected<VarType, std::string> {
+        if (m_dense_update == nullptr) {
+            return flux::unexpected{
+                std::string{"dense update function is not set"}};
+        }
+
+        if (tend <= t0) return var;
+
+        double t = t0;
         bool stop_flag = false;
+        dense.start(var, t0);
         constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
         for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
-            var = m_update(var, ex, t, stop_flag, tend);
+            var = FLUX_TIMED_STEP(
+                t, m_dense_update(var, ex, t, stop_flag, tend, dense));
         }
         if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
 
@@ -41,6 +103,7 @@ public:
 
 protected:
     UpdateFunc m_update;
+    DenseUpdateFunc m_dense_update;
 };
 
 template <VarRequirements VarType, typename ExType>
@@ -50,7 +113,8 @@ public:
     using DtFunc = std::function<double(const VarType &, ExType &, double)>;
 
     static auto get_euler_updater(OpFunc op_L, DtFunc get_dt,
-                                  OpFunc pre_process, OpFunc post_process)
+                                  OpFunc pre_process, OpFunc post_process,
+                                  ObserverBase *observer = nullptr)
         -> Solver<VarType, ExType>::UpdateFunc {
         auto no_op = [](const VarType &var, ExType &ex, double t) {
             return var;
@@ -61,25 +125,32 @@ public:
 
         return [=](const VarType &var, ExType &ex, double &t, bool &stop_flag,
                    double tend) {
-            double dt = get_dt(var, ex, t);
+            double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
             if (t + dt >= tend && t < tend) {
                 dt = tend - t;
                 stop_flag = true;
             }
-            auto var_n = pre_process(var, ex, t);
 
-            VarType var2 = var_n + dt * op_L(var_n, ex, t);
+            observe_pre_step(observer, var, t, dt);
+
+            auto var_n = FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+            VarType var2 = var_n + dt * FLUX_TIMED(op_L, op_L(var_n, ex, t));
+
+            var2 = FLUX_TIMED(post_process, post_process(var2, ex, t));
 
-            var2 = post_process(var2, ex, t);
+            observe_post_step(observer, var2, t + dt, dt);
 
             t += dt;
             return var2;
         };
     }
 
-    static auto get_rk3_updater(
-        OpFunc op_L, DtFunc get_dt, OpFunc pre_process, OpFunc post_process,
-        OpFunc post_process_rk_stage) -> Solver<VarType, ExType>::UpdateFunc {
+    static auto get_rk3_updater(OpFunc op_L, DtFunc get_dt,
+                                OpFunc pre_process, OpFunc post_process,
+                                OpFunc post_process_rk_stage,
+                                ObserverBase *observer = nullptr)
+        -> Solver<VarType, ExType>::UpdateFunc {
         auto no_op = [](const VarType &var, ExType &ex, double t) {
             return var;
         };
@@ -90,34 +161,490 @@ public:
 
         return [=](const VarType &var, ExType &ex, double &t, bool &stop_flag,
                    double tend) {
-            double dt = get_dt(var, ex, t);
+            double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
             if (t + dt >= tend && t < tend) {
                 dt = tend - t;
                 stop_flag = true;
             }
 
-            auto var_n = pre_process(var, ex, t);
+            observe_pre_step(observer, var, t, dt);
+
+            auto var_n = FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+            VarType var1 = var_n + dt * FLUX_TIMED(op_L, op_L(var_n, ex, t));
 
-            VarType var1 = var_n + dt * op_L(var_n, ex, t);
+            var1 = FLUX_TIMED(post_process_rk_stage,
+                              post_process_rk_stage(var1, ex, t));
+            observe_post_stage(observer, var1, t, dt);
 
-            var1 = post_process_rk_stage(var1, ex, t);
+            auto k = FLUX_TIMED(op_L, op_L(var1, ex, t + dt));
+            VarType var2 = (3.0 / 4) * var_n + (1.0 / 4) * (var1 + dt * k);
 
-            VarType var2 = (3.0 / 4) * var_n
-                           + (1.0 / 4) * (var1 + dt * op_L(var1, ex, t + dt));
+            var2 = FLUX_TIMED(post_process_rk_stage,
+                              post_process_rk_stage(var2, ex, t + dt));
+            observe_post_stage(observer, var2, t + dt, dt);
 
-            var2 = post_process_rk_stage(var2, ex, t + dt);
+            k = FLUX_TIMED(op_L, op_L(var2, ex, t + dt / 2));
+            VarType var3 = (1.0 / 3) * var_n + (2.0 / 3) * (var2 + dt * k);
 
-            VarType var3 =
-                (1.0 / 3) * var_n
-                + (2.0 / 3) * (var2 + dt * op_L(var2, ex, t + dt / 2));
+            var3 = FLUX_TIMED(post_process_rk_stage,
+                              post_process_rk_stage(var3, ex, t + dt / 2));
+            observe_post_stage(observer, var3, t + dt / 2, dt);
 
-            var3 = post_process_rk_stage(var3, ex, t + dt / 2);
+            var3 = FLUX_TIMED(post_process, post_process(var3, ex, t + dt));
 
-            var3 = post_process(var3, ex, t + dt);
+            observe_post_step(observer, var3, t + dt, dt);
 
             t += dt;
             return var3;
         };
     }
+
+    // RK3 with dense output, for Solver::set_dense_update
+    static auto get_rk3_dense_updater(OpFunc op_L, DtFunc get_dt,
+                                      OpFunc pre_process, OpFunc post_process,
+                                      OpFunc post_process_rk_stage,
+                                      ObserverBase *observer = nullptr)
+        -> Solver<VarType, ExType>::DenseUpdateFunc {
+        auto no_op = [](const VarType &var, ExType &ex, double t) {
+            return var;
+        };
+
+        if (pre_process == nullptr) { pre_process = no_op; }
+        if (post_process == nullptr) { post_process = no_op; }
+        if (post_process_rk_stage == nullptr) { post_process_rk_stage = no_op; }
+
+        return [=](const VarType &var, ExType &ex, double &t, bool &stop_flag,
+                   double tend, DenseOutput<VarType> &dense) {
+            double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+            if (t + dt >= tend && t < tend) {
+                dt = tend - t;
+                stop_flag = true;
+            }
+
+            observe_pre_step(observer, var, t, dt);
+
+            auto var_n = FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+            VarType var3 = ssprk3_dense_step(
+                var_n, t, dt,
+                [&](const VarType &v, double s) {
+                    return FLUX_TIMED(op_L, op_L(v, ex, s));
+                },
+                [&](const VarType &v, double s) {
+                    VarType w = FLUX_TIMED(post_process_rk_stage,
+                                           post_process_rk_stage(v, ex, s));
+                    observe_post_stage(observer, w, s, dt);
+                    return w;
+                },
+                [&](const VarType &v, double s) {
+                    return FLUX_TIMED(post_process, post_process(v, ex, s));
+                },
+                dense);
+
+            observe_post_step(observer, var3, t + dt, dt);
+
+            t += dt;
+            return var3;
+        };
+    }
+
+    // RK method given by a Shu-Osher tableau, see shu_osher.hpp
+    template <auto Tableau>
+        requires ShuOsherTableauType<decltype(Tableau)>
+    static auto get_rk_updater(
+        OpFunc op_L, DtFunc get_dt, OpFunc pre_process, OpFunc post_process,
+        OpFunc post_process_rk_stage, ObserverBase *observer = nullptr)
+        -> Solver<VarType, ExType>::UpdateFunc {
+        auto no_op = [](const VarType &var, ExType &ex, double t) {
+            return var;
+        };
+
+        if (pre_process == nullptr) { pre_process = no_op; }
+        if (post_process == nullptr) { post_process = no_op; }
+        if (post_process_rk_stage == nullptr) { post_process_rk_stage = no_op; }
+
+        return [=](const VarType &var, ExType &ex, double &t, bool &stop_flag,
+                   double tend) {
+            double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+            if (t + dt >= tend && t < tend) {
+                dt = tend - t;
+                stop_flag = true;
+            }
+
+            observe_pre_step(observer, var, t, dt);
+
+            auto var_n = FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+            VarType var2 = shu_osher_step<Tableau>(
+                var_n, t, dt,
+                [&](const VarType &v, double s) {
+                    return FLUX_TIMED(op_L, op_L(v, ex, s));
+                },
+                [&](const VarType &v, double s) {
+                    VarType w = FLUX_TIMED(post_process_rk_stage,
+                                           post_process_rk_stage(v, ex, s));
+                    observe_post_stage(observer, w, s, dt);
+                    return w;
+                });
+
+            var2 = FLUX_TIMED(post_process, post_process(var2, ex, t + dt));
+
+            observe_post_step(observer, var2, t + dt, dt);
+
+            t += dt;
+            return var2;
+        };
+    }
+};
+// In-place contract: op_L(var, out, ex, t) writes L(var) into out, the
+// processing hooks modify var directly, and the stage buffers are owned by
+// run(), so no state is allocated after the first step.
+template <InplaceVarRequirements VarType, typename ExType>
+class InplaceSolver {
+public:
+    using UpdateFunc = std::function<void(VarType &, StageBuffers<VarType> &,
+                                          ExType &, double &, bool &, double)>;
+
+    InplaceSolver &set_update(UpdateFunc update) {
+        m_update = update;
+        return *this;
+    }
+
+    auto run(VarType var, ExType &ex, double t0,
+             double tend) const -> flux::expected<VarType, std::string> {
+        if (m_update == nullptr) {
+            return flux::unexpected{std::string{"update function is not set"}};
+        }
+
+        if (tend <= t0) return var;
+
+        StageBuffers<VarType> buffers;
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            FLUX_TIMED_STEP(t, m_update(var, buffers, ex, t, stop_flag, tend));
+        }
+        if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
+
+        return var;
+    }
+
+    // run() as a lazy sequence of steps, each step yields (t, dt, var) without
+    // copying var; the solver and ex must outlive the generator.
+    auto stream(VarType var, ExType &ex, double t0, double tend) const
+        -> generator<StepView<VarType>> {
+        if (m_update == nullptr) { co_return; }
+
+        if (tend <= t0) co_return;
+
+        StageBuffers<VarType> buffers;
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            double t_old = t;
+            FLUX_TIMED_STEP(t, m_update(var, buffers, ex, t, stop_flag, tend));
+            co_yield StepView<VarType>{t, t - t_old, var};
+        }
+    }
+
+protected:
+    UpdateFunc m_update;
+};
+
+template <InplaceVarRequirements VarType, typename ExType>
+class InplaceUpdaterFactory {
+public:
+    using OpFunc =
+        std::function<void(const VarType &, VarType &, ExType &, double)>;
+    using ProcessFunc = std::function<void(VarType &, ExType &, double)>;
+    using DtFunc = std::function<double(const VarType &, ExType &, double)>;
+
+    static auto get_euler_updater(OpFunc op_L, DtFunc get_dt,
+                                  ProcessFunc pre_process,
+                                  ProcessFunc post_process,
+                                  ObserverBase *observer = nullptr)
+        -> InplaceSolver<VarType, ExType>::UpdateFunc {
+        auto no_op = [](VarType &var, ExType &ex, double t) {};
+
+        if (pre_process == nullptr) { pre_process = no_op; }
+        if (post_process == nullptr) { post_process = no_op; }
+
+        return [=](VarType &var, StageBuffers<VarType> &buffers, ExType &ex,
+                   double &t, bool &stop_flag, double tend) {
+            double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+            if (t + dt >= tend && t < tend) {
+                dt = tend - t;
+                stop_flag = true;
+            }
+
+            observe_pre_step(observer, var, t, dt);
+            FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+            auto &k = buffers.get(0, var);
+            FLUX_TIMED(op_L, op_L(var, k, ex, t));
+            var += dt * k;
+
+            FLUX_TIMED(post_process, post_process(var, ex, t));
+
+            observe_post_step(observer, var, t + dt, dt);
+
+            t += dt;
+        };
+    }
+
+    static auto get_rk3_updater(OpFunc op_L, DtFunc get_dt,
+                                ProcessFunc pre_process,
+                                ProcessFunc post_process,
+                                ProcessFunc post_process_rk_stage,
+                                ObserverBase *observer = nullptr)
+        -> InplaceSolver<VarType, ExType>::UpdateFunc {
+        auto no_op = [](VarType &var, ExType &ex, double t) {};
+
+        if (pre_process == nullptr) { pre_process = no_op; }
+        if (post_process == nullptr) { post_process = no_op; }
+        if (post_process_rk_stage == nullptr) { post_process_rk_stage = no_op; }
+
+        return [=](VarType &var, StageBuffers<VarType> &buffers, ExType &ex,
+                   double &t, bool &stop_flag, double tend) {
+            double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+            if (t + dt >= tend && t < tend) {
+                dt = tend - t;
+                stop_flag = true;
+            }
+
+            observe_pre_step(observer, var, t, dt);
+
+            FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+            auto &var_n = buffers.get(0, var);
+            auto &k = buffers.get(1, var);
+            var_n = var;
+
+            FLUX_TIMED(op_L, op_L(var_n, k, ex, t));
+            var += dt * k;
+
+            FLUX_TIMED(post_process_rk_stage,
+                       post_process_rk_stage(var, ex, t));
+            observe_post_stage(observer, var, t, dt);
+
+            FLUX_TIMED(op_L, op_L(var, k, ex, t + dt));
+            var = (3.0 / 4) * var_n + (1.0 / 4) * (var + dt * k);
+
+            FLUX_TIMED(post_process_rk_stage,
+                       post_process_rk_stage(var, ex, t + dt));
+            observe_post_stage(observer, var, t + dt, dt);
+
+            FLUX_TIMED(op_L, op_L(var, k, ex, t + dt / 2));
+            var = (1.0 / 3) * var_n + (2.0 / 3) * (var + dt * k);
+
+            FLUX_TIMED(post_process_rk_stage,
+                       post_process_rk_stage(var, ex, t + dt / 2));
+            observe_post_stage(observer, var, t + dt / 2, dt);
+
+            FLUX_TIMED(post_process, post_process(var, ex, t + dt));
+
+            observe_post_step(observer, var, t + dt, dt);
+
+            t += dt;
+        };
+    }
+
+    // writes L at u[r + i] into out[i], r = options.radius, see tiled.hpp,
+    // ex is const since the tiles run on several threads at once
+    using OpTileFunc = std::function<void(
+        std::span<const double>, std::span<double>, const ExType &, double)>;
+
+    // tiled SSP-RK3, all stages of a tile run at once, so there is no
+    // post_process_rk_stage and no stage observer
+    static auto get_tiled_rk3_updater(OpTileFunc op_L_tile, DtFunc get_dt,
+                                      ProcessFunc pre_process,
+                                      ProcessFunc post_process,
+                                      TileOptions options = {},
+                                      ObserverBase *observer = nullptr)
+        -> InplaceSolver<VarType, ExType>::UpdateFunc {
+        auto no_op = [](VarType &var, ExType &ex, double t) {};
+
+        if (pre_process == nullptr) { pre_process = no_op; }
+        if (post_process == nullptr) { post_process = no_op; }
+
+        return [=](VarType &var, StageBuffers<VarType> &buffers, ExType &ex,
+                   double &t, bool &stop_flag, double tend) {
+            double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+            if (t + dt >= tend && t < tend) {
+                dt = tend - t;
+                stop_flag = true;
+            }
+
+            observe_pre_step(observer, var, t, dt);
+
+            FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+            const ExType &tile_ex = ex;
+            FLUX_TIMED(op_L, tiled_ssprk3_update(
+                                 var, buffers, t, dt, options,
+                                 [&](std::span<const double> u,
+                                     std::span<double> out, double s) {
+                                     op_L_tile(u, out, tile_ex, s);
+                                 }));
+
+            FLUX_TIMED(post_process, post_process(var, ex, t + dt));
+
+            observe_post_step(observer, var, t + dt, dt);
+
+            t += dt;
+        };
+    }
+
+    // out = a * out + L(var)
+    using OpAccFunc = std::function<void(const VarType &, VarType &, double,
+                                         ExType &, double)>;
+
+    // 2N low-storage RK, see low_storage.hpp, only var and one buffer are used
+    template <auto Tableau>
+        requires LowStorageTableauType<decltype(Tableau)>
+    static auto get_low_storage_updater(OpAccFunc op_L_acc, DtFunc get_dt,
+                                        ProcessFunc pre_process,
+                                        ProcessFunc post_process,
+                                        ProcessFunc post_process_rk_stage,
+                                        ObserverBase *observer = nullptr)
+        -> InplaceSolver<VarType, ExType>::UpdateFunc {
+        auto no_op = [](VarType &var, ExType &ex, double t) {};
+
+        if (pre_process == nullptr) { pre_process = no_op; }
+        if (post_process == nullptr) { post_process = no_op; }
+        if (post_process_rk_stage == nullptr) { post_process_rk_stage = no_op; }
+
+        return [=](VarType &var, StageBuffers<VarType> &buffers, ExType &ex,
+                   double &t, bool &stop_flag, double tend) {
+            double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+            if (t + dt >= tend && t < tend) {
+                dt = tend - t;
+                stop_flag = true;
+            }
+
+            observe_pre_step(observer, var, t, dt);
+
+            FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+            auto &G = buffers.get(0, var);
+            low_storage_step<Tableau>(
+                var, G, t, dt,
+                [&](const VarType &v, VarType &out, double a, double s) {
+                    FLUX_TIMED(op_L, op_L_acc(v, out, a, ex, s));
+                },
+                [&](VarType &v, double s) {
+                    FLUX_TIMED(post_process_rk_stage,
+                               post_process_rk_stage(v, ex, s));
+                    observe_post_stage(observer, v, s, dt);
+                });
+
+            FLUX_TIMED(post_process, post_process(var, ex, t + dt));
+
+            observe_post_step(observer, var, t + dt, dt);
+
+            t += dt;
+        };
+    }
+};
+
+// Adaptive contract: update(var, controller, ex, t, stop_flag, tend) takes
+// one accepted step of the size proposed by the controller, which is owned
+// by run(). get_dt is the first dt and, with cfl_limit, an upper bound.
+template <VarRequirements VarType, typename ExType>
+class AdaptiveSolver {
+public:
+    using UpdateFunc = std::function<VarType(
+        const VarType &, AdaptiveController &, ExType &, double &, bool &,
+        double)>;
+
+    AdaptiveSolver &set_update(UpdateFunc update) {
+        m_update = update;
+        return *this;
+    }
+
+    AdaptiveSolver &set_options(AdaptiveOptions options) {
+        m_options = options;
+        return *this;
+    }
+
+    auto run(VarType var, ExType &ex, double t0,
+             double tend) const -> flux::expected<VarType, std::string> {
+        if (m_update == nullptr) {
+            return flux::unexpected{std::string{"update function is not set"}};
+        }
+
+        if (tend <= t0) return var;
+
+        AdaptiveController controller{m_options};
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            var = FLUX_TIMED_STEP(
+                t, m_update(var, controller, ex, t, stop_flag, tend));
+        }
+        if (controller.failed()) { return flux::unexpected{std::string{"Step size too small"}}; }
+        if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
+
+        return var;
+    }
+
+protected:
+    UpdateFunc m_update;
+    AdaptiveOptions m_options;
+};
+
+template <VarRequirements VarType, typename ExType>
+    requires IndexableVarRequirements<VarType>
+class AdaptiveUpdaterFactory {
+public:
+    using OpFunc = std::function<VarType(const VarType &, ExType &, double)>;
+    using DtFunc = std::function<double(const VarType &, ExType &, double)>;
+
+    // SSPRK(3,3) with an embedded second order solution, see adaptive.hpp
+    static auto get_rk3_updater(OpFunc op_L, DtFunc get_dt, OpFunc pre_process,
+                                OpFunc post_process,
+                                OpFunc post_process_rk_stage,
+                                ObserverBase *observer = nullptr)
+        -> AdaptiveSolver<VarType, ExType>::UpdateFunc {
+        auto no_op = [](const VarType &var, ExType &ex, double t) {
+            return var;
+        };
+
+        if (pre_process == nullptr) { pre_process = no_op; }
+        if (post_process == nullptr) { post_process = no_op; }
+        if (post_process_rk_stage == nullptr) { post_process_rk_stage = no_op; }
+
+        return [=](const VarType &var, AdaptiveController &controller,
+                   ExType &ex, double &t, bool &stop_flag, double tend) {
+            double dt_max = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+
+            // dt of the first attempt, post_step gets the dt of the accepted
+            // one
+            observe_pre_step(observer, var, t,
+                             std::min(controller.next_dt(dt_max), tend - t));
+
+            auto var_n = FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+            VarType var2 = adaptive_rk32_step(
+                var_n, controller, t, stop_flag, tend, dt_max,
+                [&](const VarType &v, double s) {
+                    return FLUX_TIMED(op_L, op_L(v, ex, s));
+                },
+                [&](const VarType &v, double s) {
+                    return FLUX_TIMED(post_process_rk_stage,
+                                      post_process_rk_stage(v, ex, s));
+                });
+            if (controller.failed()) return var2;
+
+            var2 = FLUX_TIMED(post_process, post_process(var2, ex, t));
+
+            observe_post_step(observer, var2, t, controller.last_dt());
+            return var2;
+        };
+    }
 };
 }  // namespace flux::solver_stdfunc
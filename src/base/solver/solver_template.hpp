@@ -1,10 +1,22 @@
 #pragma once
 
+#include <algorithm>
 #include <limits>
 #include <string>
+#include <utility>
 
+#include "adaptive.hpp"
+#include "dense_output.hpp"
 #include "expected.hpp"
+#include "generator.hpp"
+#include "low_storage.hpp"
+#include "observer.hpp"
+#include "parareal.hpp"
+#include "profiler.hpp"
 #include "requires.h"
+#include "shu_osher.hpp"
+#include "stage_buffers.hpp"
+#include "tiled.hpp"
 
 namespace flux::solver_template {
 
@@ -15,6 +27,17 @@ concept UpdaterRequirements =
         { updater(var, ex, t, stop_flag, tend) } -> std::same_as<VarType>;
     };
 
+// updaters with dense output, see dense_output.hpp
+template <typename UpdaterType, typename VarType, typename ExType>
+concept DenseUpdaterRequirements =
+    requires(const UpdaterType &updater, const VarType &var, ExType &ex,
+             double &t, bool &stop_flag, double tend,
+             DenseOutput<VarType> &dense) {
+        {
+            updater.update_dense(var, ex, t, stop_flag, tend, dense)
+        } -> std::same_as<VarType>;
+    };
+
 template <VarRequirements VarType, typename ExType, typename UpdaterType>
     requires UpdaterRequirements<UpdaterType, VarType, ExType>
 class Solver {
@@ -25,11 +48,48 @@ public:
              double tend) const -> flux::expected<VarType, std::string> {
         if (tend <= t0) return var;
 
-        double t = 0;
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            var = FLUX_TIMED_STEP(t, updater(var, ex, t, stop_flag, tend));
+        }
+        if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
+
+        return var;
+    }
+
+    // run() as a lazy sequence of steps, each step yields (t, dt, var) without
+    // copying var; the solver and ex must outlive the generator.
+    auto stream(VarType var, ExType &ex, double t0, double tend) const
+        -> generator<StepView<VarType>> {
+        if (tend <= t0) co_return;
+
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            double t_old = t;
+            var = FLUX_TIMED_STEP(t, updater(var, ex, t, stop_flag, tend));
+            co_yield StepView<VarType>{t, t - t_old, var};
+        }
+    }
+
+    // run() which also reports the state at the output times of dense
+    auto run_dense(VarType var, ExType &ex, double t0, double tend,
+                   DenseOutput<VarType> &dense) const
+        -> flux::expected<VarType, std::string>
+        requires DenseUpdaterRequirements<UpdaterType, VarType, ExType>
+    {
+        if (tend <= t0) return var;
+
+        double t = t0;
         bool stop_flag = false;
+        dense.start(var, t0);
         constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
         for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
-            var = updater(var, ex, t, stop_flag, tend);
+            var = FLUX_TIMED_STEP(
+                t, updater.update_dense(var, ex, t, stop_flag, tend, dense));
         }
         if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
 
@@ -57,31 +117,38 @@ struct OpNull {
 };
 
 template <VarRequirements VarType, typename ExType, typename OpType,
-          typename GetDtType, typename PreProcessType, typename PostProcessType>
+          typename GetDtType, typename PreProcessType, typename PostProcessType,
+          typename ObserverType = NullObserver>
     requires OpRequirements<OpType, VarType, ExType>
              && GetDtRequirements<GetDtType, VarType, ExType>
              && OpRequirements<PreProcessType, VarType, ExType>
              && OpRequirements<PostProcessType, VarType, ExType>
+             && ObserverTypeRequirements<ObserverType>
 class EulerUpdater {
 public:
     OpType op_L;
     GetDtType get_dt;
     PreProcessType pre_process;
     PostProcessType post_process;
+    ObserverType observer{};
 
     VarType operator()(const VarType &var, ExType &ex, double &t,
                        bool &stop_flag, double tend) const {
-        double dt = get_dt(var, ex, t);
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
         if (t + dt >= tend && t < tend) {
             dt = tend - t;
             stop_flag = true;
         }
 
-        auto var_n = pre_process(var, ex, t);
+        observe_pre_step(observer, var, t, dt);
+
+        auto var_n = FLUX_TIMED(pre_process, pre_process(var, ex, t));
 
-        VarType var2 = var_n + dt * op_L(var_n, ex, t);
+        VarType var2 = var_n + dt * FLUX_TIMED(op_L, op_L(var_n, ex, t));
 
-        var2 = post_process(var2, ex, t);
+        var2 = FLUX_TIMED(post_process, post_process(var2, ex, t));
+
+        observe_post_step(observer, var2, t + dt, dt);
 
         t += dt;
         return var2;
@@ -90,12 +157,14 @@ public:
 
 template <VarRequirements VarType, typename ExType, typename OpType,
           typename GetDtType, typename PreProcessType, typename PostProcessType,
-          typename PostProcessRKStageType>
+          typename PostProcessRKStageType,
+          typename ObserverType = NullObserver>
     requires OpRequirements<OpType, VarType, ExType>
              && GetDtRequirements<GetDtType, VarType, ExType>
              && OpRequirements<PreProcessType, VarType, ExType>
              && OpRequirements<PostProcessType, VarType, ExType>
              && OpRequirements<PostProcessRKStageType, VarType, ExType>
+             && ObserverTypeRequirements<ObserverType>
 class RK3Updater {
 public:
     OpType op_L;
@@ -103,35 +172,535 @@ public:
     PreProcessType pre_process;
     PostProcessType post_process;
     PostProcessRKStageType post_process_rk_stage;
+    ObserverType observer{};
 
     VarType operator()(const VarType &var, ExType &ex, double &t,
                        bool &stop_flag, double tend) const {
-        double dt = get_dt(var, ex, t);
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
         if (t + dt >= tend && t < tend) {
             dt = tend - t;
             stop_flag = true;
         }
 
-        auto var_n = pre_process(var, ex, t);
+        observe_pre_step(observer, var, t, dt);
+
+        auto var_n = FLUX_TIMED(pre_process, pre_process(var, ex, t));
 
-        VarType var1 = var_n + dt * op_L(var_n, ex, t);
+        VarType var1 = var_n + dt * FLUX_TIMED(op_L, op_L(var_n, ex, t));
 
-        var1 = post_process_rk_stage(var1, ex, t);
+        var1 = FLUX_TIMED(post_process_rk_stage,
+                          post_process_rk_stage(var1, ex, t));
+        observe_post_stage(observer, var1, t, dt);
 
-        VarType var2 = (3.0 / 4) * var_n
-                       + (1.0 / 4) * (var1 + dt * op_L(var1, ex, t + dt));
+        auto k = FLUX_TIMED(op_L, op_L(var1, ex, t + dt));
+        VarType var2 = (3.0 / 4) * var_n + (1.0 / 4) * (var1 + dt * k);
 
-        var2 = post_process_rk_stage(var2, ex, t + dt);
+        var2 = FLUX_TIMED(post_process_rk_stage,
+                          post_process_rk_stage(var2, ex, t + dt));
+        observe_post_stage(observer, var2, t + dt, dt);
 
-        VarType var3 = (1.0 / 3) * var_n
-                       + (2.0 / 3) * (var2 + dt * op_L(var2, ex, t + dt / 2));
+        k = FLUX_TIMED(op_L, op_L(var2, ex, t + dt / 2));
+        VarType var3 = (1.0 / 3) * var_n + (2.0 / 3) * (var2 + dt * k);
 
-        var3 = post_process_rk_stage(var3, ex, t + dt / 2);
+        var3 = FLUX_TIMED(post_process_rk_stage,
+                          post_process_rk_stage(var3, ex, t + dt / 2));
+        observe_post_stage(observer, var3, t + dt / 2, dt);
 
-        var3 = post_process(var3, ex, t + dt);
+        var3 = FLUX_TIMED(post_process, post_process(var3, ex, t + dt));
+
+        observe_post_step(observer, var3, t + dt, dt);
 
         t += dt;
         return var3;
     }
+
+    VarType update_dense(const VarType &var, ExType &ex, double &t,
+                         bool &stop_flag, double tend,
+                         DenseOutput<VarType> &dense) const {
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(observer, var, t, dt);
+
+        auto var_n = FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+        VarType var3 = ssprk3_dense_step(
+            var_n, t, dt,
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(op_L, op_L(v, ex, s));
+            },
+            [&](const VarType &v, double s) {
+                VarType w = FLUX_TIMED(post_process_rk_stage,
+                                       post_process_rk_stage(v, ex, s));
+                observe_post_stage(observer, w, s, dt);
+                return w;
+            },
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(post_process, post_process(v, ex, s));
+            },
+            dense);
+
+        observe_post_step(observer, var3, t + dt, dt);
+
+        t += dt;
+        return var3;
+    }
+};
+
+// RK method given by a Shu-Osher tableau, see shu_osher.hpp
+template <VarRequirements VarType, typename ExType, auto Tableau,
+          typename OpType, typename GetDtType, typename PreProcessType,
+          typename PostProcessType, typename PostProcessRKStageType,
+          typename ObserverType = NullObserver>
+    requires ShuOsherTableauType<decltype(Tableau)>
+             && OpRequirements<OpType, VarType, ExType>
+             && GetDtRequirements<GetDtType, VarType, ExType>
+             && OpRequirements<PreProcessType, VarType, ExType>
+             && OpRequirements<PostProcessType, VarType, ExType>
+             && OpRequirements<PostProcessRKStageType, VarType, ExType>
+             && ObserverTypeRequirements<ObserverType>
+class RKUpdater {
+public:
+    OpType op_L;
+    GetDtType get_dt;
+    PreProcessType pre_process;
+    PostProcessType post_process;
+    PostProcessRKStageType post_process_rk_stage;
+    ObserverType observer{};
+
+    VarType operator()(const VarType &var, ExType &ex, double &t,
+                       bool &stop_flag, double tend) const {
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(observer, var, t, dt);
+
+        auto var_n = FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+        VarType var2 = shu_osher_step<Tableau>(
+            var_n, t, dt,
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(op_L, op_L(v, ex, s));
+            },
+            [&](const VarType &v, double s) {
+                VarType w = FLUX_TIMED(post_process_rk_stage,
+                                       post_process_rk_stage(v, ex, s));
+                observe_post_stage(observer, w, s, dt);
+                return w;
+            });
+
+        var2 = FLUX_TIMED(post_process, post_process(var2, ex, t + dt));
+
+        observe_post_step(observer, var2, t + dt, dt);
+
+        t += dt;
+        return var2;
+    }
+};
+
+// In-place contract: op_L(var, out, ex, t) writes L(var) into out, the
+// processing hooks modify var directly, and the stage buffers are owned by
+// run(), so no state is allocated after the first step.
+template <typename UpdaterType, typename VarType, typename ExType>
+concept InplaceUpdaterRequirements =
+    requires(const UpdaterType &updater, VarType &var,
+             StageBuffers<VarType> &buffers, ExType &ex, double &t,
+             bool &stop_flag, double tend) {
+        { updater(var, buffers, ex, t, stop_flag, tend) } -> std::same_as<void>;
+    };
+
+template <InplaceVarRequirements VarType, typename ExType, typename UpdaterType>
+    requires InplaceUpdaterRequirements<UpdaterType, VarType, ExType>
+class InplaceSolver {
+public:
+    UpdaterType updater;
+
+    auto run(VarType var, ExType &ex, double t0,
+             double tend) const -> flux::expected<VarType, std::string> {
+        if (tend <= t0) return var;
+
+        StageBuffers<VarType> buffers;
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            FLUX_TIMED_STEP(t, updater(var, buffers, ex, t, stop_flag, tend));
+        }
+        if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
+
+        return var;
+    }
+
+    // run() as a lazy sequence of steps, each step yields (t, dt, var) without
+    // copying var; the solver and ex must outlive the generator.
+    auto stream(VarType var, ExType &ex, double t0, double tend) const
+        -> generator<StepView<VarType>> {
+        if (tend <= t0) co_return;
+
+        StageBuffers<VarType> buffers;
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            double t_old = t;
+            FLUX_TIMED_STEP(t, updater(var, buffers, ex, t, stop_flag, tend));
+            co_yield StepView<VarType>{t, t - t_old, var};
+        }
+    }
+};
+
+template <typename OpType, typename VarType, typename ExType>
+concept InplaceOpRequirements = requires(const OpType &op, const VarType &var,
+                                         VarType &out, ExType &ex, double t) {
+    { op(var, out, ex, t) } -> std::same_as<void>;
+};
+
+template <typename ProcessType, typename VarType, typename ExType>
+concept InplaceProcessRequirements =
+    requires(const ProcessType &process, VarType &var, ExType &ex, double t) {
+        { process(var, ex, t) } -> std::same_as<void>;
+    };
+
+template <VarRequirements VarType, typename ExType>
+struct InplaceOpNull {
+    void operator()(VarType &var, ExType &ex, double t) const {}
+};
+
+template <InplaceVarRequirements VarType, typename ExType, typename OpType,
+          typename GetDtType, typename PreProcessType, typename PostProcessType,
+          typename ObserverType = NullObserver>
+    requires InplaceOpRequirements<OpType, VarType, ExType>
+             && GetDtRequirements<GetDtType, VarType, ExType>
+             && InplaceProcessRequirements<PreProcessType, VarType, ExType>
+             && InplaceProcessRequirements<PostProcessType, VarType, ExType>
+             && ObserverTypeRequirements<ObserverType>
+class EulerInplaceUpdater {
+public:
+    OpType op_L;
+    GetDtType get_dt;
+    PreProcessType pre_process;
+    PostProcessType post_process;
+    ObserverType observer{};
+
+    void operator()(VarType &var, StageBuffers<VarType> &buffers, ExType &ex,
+                    double &t, bool &stop_flag, double tend) const {
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(observer, var, t, dt);
+
+        FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+        auto &k = buffers.get(0, var);
+        FLUX_TIMED(op_L, op_L(var, k, ex, t));
+        var += dt * k;
+
+        FLUX_TIMED(post_process, post_process(var, ex, t));
+
+        observe_post_step(observer, var, t + dt, dt);
+
+        t += dt;
+    }
+};
+
+template <InplaceVarRequirements VarType, typename ExType, typename OpType,
+          typename GetDtType, typename PreProcessType, typename PostProcessType,
+          typename PostProcessRKStageType,
+          typename ObserverType = NullObserver>
+    requires InplaceOpRequirements<OpType, VarType, ExType>
+             && GetDtRequirements<GetDtType, VarType, ExType>
+             && InplaceProcessRequirements<PreProcessType, VarType, ExType>
+             && InplaceProcessRequirements<PostProcessType, VarType, ExType>
+             && InplaceProcessRequirements<PostProcessRKStageType, VarType,
+                                           ExType>
+             && ObserverTypeRequirements<ObserverType>
+class RK3InplaceUpdater {
+public:
+    OpType op_L;
+    GetDtType get_dt;
+    PreProcessType pre_process;
+    PostProcessType post_process;
+    PostProcessRKStageType post_process_rk_stage;
+    ObserverType observer{};
+
+    void operator()(VarType &var, StageBuffers<VarType> &buffers, ExType &ex,
+                    double &t, bool &stop_flag, double tend) const {
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(observer, var, t, dt);
+
+        FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+        auto &var_n = buffers.get(0, var);
+        auto &k = buffers.get(1, var);
+        var_n = var;
+
+        FLUX_TIMED(op_L, op_L(var_n, k, ex, t));
+        var += dt * k;
+
+        FLUX_TIMED(post_process_rk_stage, post_process_rk_stage(var, ex, t));
+        observe_post_stage(observer, var, t, dt);
+
+        FLUX_TIMED(op_L, op_L(var, k, ex, t + dt));
+        var = (3.0 / 4) * var_n + (1.0 / 4) * (var + dt * k);
+
+        FLUX_TIMED(post_process_rk_stage,
+                   post_process_rk_stage(var, ex, t + dt));
+        observe_post_stage(observer, var, t + dt, dt);
+
+        FLUX_TIMED(op_L, op_L(var, k, ex, t + dt / 2));
+        var = (1.0 / 3) * var_n + (2.0 / 3) * (var + dt * k);
+
+        FLUX_TIMED(post_process_rk_stage,
+                   post_process_rk_stage(var, ex, t + dt / 2));
+        observe_post_stage(observer, var, t + dt / 2, dt);
+
+        FLUX_TIMED(post_process, post_process(var, ex, t + dt));
+
+        observe_post_step(observer, var, t + dt, dt);
+
+        t += dt;
+    }
+};
+
+// writes L at u[r + i] into out[i], see tiled.hpp, ex is const since the
+// tiles run on several threads at once
+template <typename OpType, typename ExType>
+concept TileOpRequirements =
+    requires(const OpType &op, std::span<const double> u,
+             std::span<double> out, const ExType &ex, double t) {
+        { op(u, out, ex, t) } -> std::same_as<void>;
+    };
+
+// tiled SSP-RK3, all stages of a tile run at once, so there is no
+// post_process_rk_stage and no stage observer
+template <InplaceVarRequirements VarType, typename ExType, typename OpTileType,
+          typename GetDtType, typename PreProcessType, typename PostProcessType,
+          typename ObserverType = NullObserver>
+    requires TileableVarRequirements<VarType>
+             && TileOpRequirements<OpTileType, ExType>
+             && GetDtRequirements<GetDtType, VarType, ExType>
+             && InplaceProcessRequirements<PreProcessType, VarType, ExType>
+             && InplaceProcessRequirements<PostProcessType, VarType, ExType>
+             && ObserverTypeRequirements<ObserverType>
+class TiledRK3Updater {
+public:
+    OpTileType op_L_tile;
+    GetDtType get_dt;
+    PreProcessType pre_process;
+    PostProcessType post_process;
+    TileOptions options{};
+    ObserverType observer{};
+
+    void operator()(VarType &var, StageBuffers<VarType> &buffers, ExType &ex,
+                    double &t, bool &stop_flag, double tend) const {
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(observer, var, t, dt);
+
+        FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+        const ExType &tile_ex = ex;
+        FLUX_TIMED(op_L, tiled_ssprk3_update(
+                             var, buffers, t, dt, options,
+                             [&](std::span<const double> u,
+                                 std::span<double> out, double s) {
+                                 op_L_tile(u, out, tile_ex, s);
+                             }));
+
+        FLUX_TIMED(post_process, post_process(var, ex, t + dt));
+
+        observe_post_step(observer, var, t + dt, dt);
+
+        t += dt;
+    }
+};
+
+// out = a * out + L(var)
+template <typename OpType, typename VarType, typename ExType>
+concept InplaceOpAccRequirements =
+    requires(const OpType &op, const VarType &var, VarType &out, double a,
+             ExType &ex, double t) {
+        { op(var, out, a, ex, t) } -> std::same_as<void>;
+    };
+
+// 2N low-storage RK, see low_storage.hpp, only var and one buffer are used.
+template <InplaceVarRequirements VarType, typename ExType, auto Tableau,
+          typename OpAccType, typename GetDtType, typename PreProcessType,
+          typename PostProcessType, typename PostProcessRKStageType,
+          typename ObserverType = NullObserver>
+    requires LowStorageTableauType<decltype(Tableau)>
+             && InplaceOpAccRequirements<OpAccType, VarType, ExType>
+             && GetDtRequirements<GetDtType, VarType, ExType>
+             && InplaceProcessRequirements<PreProcessType, VarType, ExType>
+             && InplaceProcessRequirements<PostProcessType, VarType, ExType>
+             && InplaceProcessRequirements<PostProcessRKStageType, VarType,
+                                           ExType>
+             && ObserverTypeRequirements<ObserverType>
+class LowStorageUpdater {
+public:
+    OpAccType op_L_acc;
+    GetDtType get_dt;
+    PreProcessType pre_process;
+    PostProcessType post_process;
+    PostProcessRKStageType post_process_rk_stage;
+    ObserverType observer{};
+
+    void operator()(VarType &var, StageBuffers<VarType> &buffers, ExType &ex,
+                    double &t, bool &stop_flag, double tend) const {
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(observer, var, t, dt);
+
+        FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+        auto &G = buffers.get(0, var);
+        low_storage_step<Tableau>(
+            var, G, t, dt,
+            [&](const VarType &v, VarType &out, double a, double s) {
+                FLUX_TIMED(op_L, op_L_acc(v, out, a, ex, s));
+            },
+            [&](VarType &v, double s) {
+                FLUX_TIMED(post_process_rk_stage,
+                           post_process_rk_stage(v, ex, s));
+                observe_post_stage(observer, v, s, dt);
+            });
+
+        FLUX_TIMED(post_process, post_process(var, ex, t + dt));
+
+        observe_post_step(observer, var, t + dt, dt);
+
+        t += dt;
+    }
+};
+
+// Adaptive contract: update(var, controller, ex, t, stop_flag, tend) takes
+// one accepted step of the size proposed by the controller, which is owned
+// by run(). get_dt is the first dt and, with cfl_limit, an upper bound.
+template <typename UpdaterType, typename VarType, typename ExType>
+concept AdaptiveUpdaterRequirements =
+    requires(const UpdaterType &updater, const VarType &var,
+             AdaptiveController &controller, ExType &ex, double &t,
+             bool &stop_flag, double tend) {
+        {
+            updater(var, controller, ex, t, stop_flag, tend)
+        } -> std::same_as<VarType>;
+    };
+
+template <VarRequirements VarType, typename ExType, typename UpdaterType>
+    requires AdaptiveUpdaterRequirements<UpdaterType, VarType, ExType>
+class AdaptiveSolver {
+public:
+    UpdaterType updater;
+    AdaptiveOptions options;
+
+    auto run(VarType var, ExType &ex, double t0,
+             double tend) const -> flux::expected<VarType, std::string> {
+        if (tend <= t0) return var;
+
+        AdaptiveController controller{options};
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            var = FLUX_TIMED_STEP(
+                t, updater(var, controller, ex, t, stop_flag, tend));
+        }
+        if (controller.failed()) { return flux::unexpected{std::string{"Step size too small"}}; }
+        if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
+
+        return var;
+    }
+};
+
+// SSPRK(3,3) with an embedded second order solution, see adaptive.hpp
+template <VarRequirements VarType, typename ExType, typename OpType,
+          typename GetDtType, typename PreProcessType, typename PostProcessType,
+          typename PostProcessRKStageType, typename ObserverType = NullObserver>
+    requires IndexableVarRequirements<VarType>
+             && OpRequirements<OpType, VarType, ExType>
+             && GetDtRequirements<GetDtType, VarType, ExType>
+             && OpRequirements<PreProcessType, VarType, ExType>
+             && OpRequirements<PostProcessType, VarType, ExType>
+             && OpRequirements<PostProcessRKStageType, VarType, ExType>
+             && ObserverTypeRequirements<ObserverType>
+class AdaptiveRK3Updater {
+public:
+    OpType op_L;
+    GetDtType get_dt;
+    PreProcessType pre_process;
+    PostProcessType post_process;
+    PostProcessRKStageType post_process_rk_stage;
+    ObserverType observer{};
+
+    VarType operator()(const VarType &var, AdaptiveController &controller,
+                       ExType &ex, double &t, bool &stop_flag,
+                       double tend) const {
+        double dt_max = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+
+        // dt of the first attempt, post_step gets the dt of the accepted one
+        observe_pre_step(observer, var, t,
+                         std::min(controller.next_dt(dt_max), tend - t));
+
+        auto var_n = FLUX_TIMED(pre_process, pre_process(var, ex, t));
+
+        VarType var2 = adaptive_rk32_step(
+            var_n, controller, t, stop_flag, tend, dt_max,
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(op_L, op_L(v, ex, s));
+            },
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(post_process_rk_stage,
+                                  post_process_rk_stage(v, ex, s));
+            });
+        if (controller.failed()) return var2;
+
+        var2 = FLUX_TIMED(post_process, post_process(var2, ex, t));
+
+        observe_post_step(observer, var2, t, controller.last_dt());
+        return var2;
+    }
+};
+
+// Parareal with two solvers of this framework, e.g. an EulerUpdater with a
+// first order flux as coarse and an RK3Updater with WENO5 as fine solver,
+// see parareal.hpp
+template <VarRequirements VarType, typename ExType, typename CoarseType,
+          typename FineType>
+    requires PropagatorRequirements<CoarseType, VarType, ExType>
+             && PropagatorRequirements<FineType, VarType, ExType>
+class PararealSolver {
+public:
+    CoarseType coarse;
+    FineType fine;
+    PararealOptions options{};
+
+    auto run(VarType var, ExType &ex, double t0, double tend,
+             PararealReport *report = nullptr) const
+        -> flux::expected<VarType, std::string> {
+        return parareal(coarse, fine, std::move(var), ex, t0, tend, options,
+                        report);
+    }
 };
 }  // namespace flux::solver_template
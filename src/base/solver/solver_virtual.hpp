@@ -1,10 +1,20 @@
 #pragma once
 
+#include <algorithm>
 #include <limits>
 #include <string>
 
+#include "adaptive.hpp"
+#include "dense_output.hpp"
 #include "expected.hpp"
+#include "generator.hpp"
+#include "low_storage.hpp"
+#include "observer.hpp"
+#include "profiler.hpp"
 #include "requires.h"
+#include "shu_osher.hpp"
+#include "stage_buffers.hpp"
+#include "tiled.hpp"
 
 namespace flux::solver_virtual {
 
@@ -15,11 +25,11 @@ public:
              double tend) const -> flux::expected<VarType, std::string> {
         if (tend <= t0) return var;
 
-        double t = 0;
+        double t = t0;
         bool stop_flag = false;
         constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
         for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
-            var = update(var, ex, t, stop_flag, tend);
+            var = FLUX_TIMED_STEP(t, update(var, ex, t, stop_flag, tend));
         }
         if (!stop_flag) {
             return flux::unexpected{std::string{"Iteration exceeds"}};
@@ -28,6 +38,22 @@ public:
         return var;
     }
 
+    // run() as a lazy sequence of steps, each step yields (t, dt, var) without
+    // copying var; the solver and ex must outlive the generator.
+    auto stream(VarType var, ExType &ex, double t0, double tend) const
+        -> generator<StepView<VarType>> {
+        if (tend <= t0) co_return;
+
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            double t_old = t;
+            var = FLUX_TIMED_STEP(t, update(var, ex, t, stop_flag, tend));
+            co_yield StepView<VarType>{t, t - t_old, var};
+        }
+    }
+
     virtual VarType update(const VarType &var, ExType &ex, double &t,
                            bool &stop_flag, double tend) const = 0;
 
@@ -51,19 +77,26 @@ public:
         return var;
     }
 
+    // no observer by default, see observer.hpp
+    virtual ObserverBase *observer() const { return nullptr; }
+
     VarType update(const VarType &var, ExType &ex, double &t, bool &stop_flag,
                    double tend) const override {
-        double dt = get_dt(var, ex, t);
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
         if (t + dt >= tend && t < tend) {
             dt = tend - t;
             stop_flag = true;
         }
 
-        auto var_n = this->pre_process(var, ex, t);
+        observe_pre_step(observer(), var, t, dt);
 
-        VarType var2 = var_n + dt * op_L(var_n, ex, t);
+        auto var_n = FLUX_TIMED(pre_process, this->pre_process(var, ex, t));
 
-        var2 = this->post_process(var2, ex, t);
+        VarType var2 = var_n + dt * FLUX_TIMED(op_L, op_L(var_n, ex, t));
+
+        var2 = FLUX_TIMED(post_process, this->post_process(var2, ex, t));
+
+        observe_post_step(observer(), var2, t + dt, dt);
 
         t += dt;
         return var2;
@@ -92,34 +125,506 @@ public:
         return var;
     }
 
+    // no observer by default, see observer.hpp
+    virtual ObserverBase *observer() const { return nullptr; }
+
     VarType update(const VarType &var, ExType &ex, double &t, bool &stop_flag,
                    double tend) const override {
-        double dt = get_dt(var, ex, t);
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
         if (t + dt >= tend && t < tend) {
             dt = tend - t;
             stop_flag = true;
         }
 
-        auto var_n = this->pre_process(var, ex, t);
+        observe_pre_step(observer(), var, t, dt);
+
+        auto var_n = FLUX_TIMED(pre_process, this->pre_process(var, ex, t));
 
-        VarType var1 = var_n + dt * op_L(var_n, ex, t);
+        VarType var1 = var_n + dt * FLUX_TIMED(op_L, op_L(var_n, ex, t));
 
-        var1 = post_process_rk_stage(var1, ex, t);
+        var1 = FLUX_TIMED(post_process_rk_stage,
+                          post_process_rk_stage(var1, ex, t));
+        observe_post_stage(observer(), var1, t, dt);
 
-        VarType var2 = (3.0 / 4) * var_n
-                       + (1.0 / 4) * (var1 + dt * op_L(var1, ex, t + dt));
+        auto k = FLUX_TIMED(op_L, op_L(var1, ex, t + dt));
+        VarType var2 = (3.0 / 4) * var_n + (1.0 / 4) * (var1 + dt * k);
 
-        var2 = post_process_rk_stage(var2, ex, t + dt);
+        var2 = FLUX_TIMED(post_process_rk_stage,
+                          post_process_rk_stage(var2, ex, t + dt));
+        observe_post_stage(observer(), var2, t + dt, dt);
 
-        VarType var3 = (1.0 / 3) * var_n
-                       + (2.0 / 3) * (var2 + dt * op_L(var2, ex, t + dt / 2));
+        k = FLUX_TIMED(op_L, op_L(var2, ex, t + dt / 2));
+        VarType var3 = (1.0 / 3) * var_n + (2.0 / 3) * (var2 + dt * k);
 
-        var3 = post_process_rk_stage(var3, ex, t + dt / 2);
+        var3 = FLUX_TIMED(post_process_rk_stage,
+                          post_process_rk_stage(var3, ex, t + dt / 2));
+        observe_post_stage(observer(), var3, t + dt / 2, dt);
 
-        var3 = this->post_process(var3, ex, t + dt);
+        var3 = FLUX_TIMED(post_process, this->post_process(var3, ex, t + dt));
+
+        observe_post_step(observer(), var3, t + dt, dt);
 
         t += dt;
         return var3;
     }
+
+    VarType update_dense(const VarType &var, ExType &ex, double &t,
+                         bool &stop_flag, double tend,
+                         DenseOutput<VarType> &dense) const {
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(observer(), var, t, dt);
+
+        auto var_n = FLUX_TIMED(pre_process, this->pre_process(var, ex, t));
+
+        VarType var3 = ssprk3_dense_step(
+            var_n, t, dt,
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(op_L, op_L(v, ex, s));
+            },
+            [&](const VarType &v, double s) {
+                VarType w = FLUX_TIMED(post_process_rk_stage,
+                                       post_process_rk_stage(v, ex, s));
+                observe_post_stage(observer(), w, s, dt);
+                return w;
+            },
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(post_process, this->post_process(v, ex, s));
+            },
+            dense);
+
+        observe_post_step(observer(), var3, t + dt, dt);
+
+        t += dt;
+        return var3;
+    }
+
+    // run() which also reports the state at the output times of dense
+    auto run_dense(VarType var, ExType &ex, double t0, double tend,
+                   DenseOutput<VarType> &dense) const
+        -> flux::expected<VarType, std::string> {
+        if (tend <= t0) return var;
+
+        double t = t0;
+        bool stop_flag = false;
+        dense.start(var, t0);
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            var = FLUX_TIMED_STEP(
+                t, update_dense(var, ex, t, stop_flag, tend, dense));
+        }
+        if (!stop_flag) { return flux::unexpected{std::string{"Iteration exceeds"}}; }
+
+        return var;
+    }
+};
+
+// RK method given by a Shu-Osher tableau, see shu_osher.hpp
+template <VarRequirements VarType, typename ExType, auto Tableau>
+    requires ShuOsherTableauType<decltype(Tableau)>
+class RKSolver : public Solver<VarType, ExType> {
+public:
+    virtual double get_dt(const VarType &var, ExType &ex, double t) const = 0;
+
+    virtual VarType op_L(const VarType &var, ExType &ex, double t) const = 0;
+
+    virtual VarType post_process(const VarType &var, ExType &ex,
+                                 double t) const {
+        return var;
+    }
+
+    virtual VarType pre_process(const VarType &var, ExType &ex,
+                                double t) const {
+        return var;
+    }
+
+    virtual VarType post_process_rk_stage(const VarType &var, ExType &ex,
+                                          double t) const {
+        return var;
+    }
+
+    // no observer by default, see observer.hpp
+    virtual ObserverBase *observer() const { return nullptr; }
+
+    VarType update(const VarType &var, ExType &ex, double &t, bool &stop_flag,
+                   double tend) const override {
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(observer(), var, t, dt);
+
+        auto var_n = FLUX_TIMED(pre_process, this->pre_process(var, ex, t));
+
+        VarType var2 = shu_osher_step<Tableau>(
+            var_n, t, dt,
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(op_L, op_L(v, ex, s));
+            },
+            [&](const VarType &v, double s) {
+                VarType w = FLUX_TIMED(post_process_rk_stage,
+                                       post_process_rk_stage(v, ex, s));
+                observe_post_stage(observer(), w, s, dt);
+                return w;
+            });
+
+        var2 = FLUX_TIMED(post_process, this->post_process(var2, ex, t + dt));
+
+        observe_post_step(observer(), var2, t + dt, dt);
+
+        t += dt;
+        return var2;
+    }
+};
+
+// In-place contract: op_L(var, out, ex, t) writes L(var) into out, the
+// processing hooks modify var directly, and the stage buffers are owned by
+// run(), so no state is allocated after the first step.
+template <InplaceVarRequirements VarType, typename ExType>
+class InplaceSolver {
+public:
+    auto run(VarType var, ExType &ex, double t0,
+             double tend) const -> flux::expected<VarType, std::string> {
+        if (tend <= t0) return var;
+
+        StageBuffers<VarType> buffers;
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            FLUX_TIMED_STEP(t, update(var, buffers, ex, t, stop_flag, tend));
+        }
+        if (!stop_flag) {
+            return flux::unexpected{std::string{"Iteration exceeds"}};
+        }
+
+        return var;
+    }
+
+    // run() as a lazy sequence of steps, each step yields (t, dt, var) without
+    // copying var; the solver and ex must outlive the generator.
+    auto stream(VarType var, ExType &ex, double t0, double tend) const
+        -> generator<StepView<VarType>> {
+        if (tend <= t0) co_return;
+
+        StageBuffers<VarType> buffers;
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            double t_old = t;
+            FLUX_TIMED_STEP(t, update(var, buffers, ex, t, stop_flag, tend));
+            co_yield StepView<VarType>{t, t - t_old, var};
+        }
+    }
+
+    virtual void update(VarType &var, StageBuffers<VarType> &buffers,
+                        ExType &ex, double &t, bool &stop_flag,
+                        double tend) const = 0;
+
+    virtual ~InplaceSolver() = default;
+};
+
+template <InplaceVarRequirements VarType, typename ExType>
+class EulerInplaceSolver : public InplaceSolver<VarType, ExType> {
+public:
+    virtual double get_dt(const VarType &var, ExType &ex, double t) const = 0;
+
+    virtual void op_L(const VarType &var, VarType &out, ExType &ex,
+                      double t) const = 0;
+
+    virtual void post_process(VarType &var, ExType &ex, double t) const {}
+
+    virtual void pre_process(VarType &var, ExType &ex, double t) const {}
+
+    // no observer by default, see observer.hpp
+    virtual ObserverBase *observer() const { return nullptr; }
+
+    void update(VarType &var, StageBuffers<VarType> &buffers, ExType &ex,
+                double &t, bool &stop_flag, double tend) const override {
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(observer(), var, t, dt);
+
+        FLUX_TIMED(pre_process, this->pre_process(var, ex, t));
+
+        auto &k = buffers.get(0, var);
+        FLUX_TIMED(op_L, op_L(var, k, ex, t));
+        var += dt * k;
+
+        FLUX_TIMED(post_process, this->post_process(var, ex, t));
+
+        observe_post_step(observer(), var, t + dt, dt);
+
+        t += dt;
+    }
+};
+
+template <InplaceVarRequirements VarType, typename ExType>
+class RK3InplaceSolver : public InplaceSolver<VarType, ExType> {
+public:
+    virtual double get_dt(const VarType &var, ExType &ex, double t) const = 0;
+
+    virtual void op_L(const VarType &var, VarType &out, ExType &ex,
+                      double t) const = 0;
+
+    virtual void post_process(VarType &var, ExType &ex, double t) const {}
+
+    virtual void pre_process(VarType &var, ExType &ex, double t) const {}
+
+    virtual void post_process_rk_stage(VarType &var, ExType &ex,
+                                       double t) const {}
+
+    // no observer by default, see observer.hpp
+    virtual ObserverBase *observer() const { return nullptr; }
+
+    void update(VarType &var, StageBuffers<VarType> &buffers, ExType &ex,
+                double &t, bool &stop_flag, double tend) const override {
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(observer(), var, t, dt);
+
+        FLUX_TIMED(pre_process, this->pre_process(var, ex, t));
+
+        auto &var_n = buffers.get(0, var);
+        auto &k = buffers.get(1, var);
+        var_n = var;
+
+        FLUX_TIMED(op_L, op_L(var_n, k, ex, t));
+        var += dt * k;
+
+        FLUX_TIMED(post_process_rk_stage, post_process_rk_stage(var, ex, t));
+        observe_post_stage(observer(), var, t, dt);
+
+        FLUX_TIMED(op_L, op_L(var, k, ex, t + dt));
+        var = (3.0 / 4) * var_n + (1.0 / 4) * (var + dt * k);
+
+        FLUX_TIMED(post_process_rk_stage,
+                   post_process_rk_stage(var, ex, t + dt));
+        observe_post_stage(observer(), var, t + dt, dt);
+
+        FLUX_TIMED(op_L, op_L(var, k, ex, t + dt / 2));
+        var = (1.0 / 3) * var_n + (2.0 / 3) * (var + dt * k);
+
+        FLUX_TIMED(post_process_rk_stage,
+                   post_process_rk_stage(var, ex, t + dt / 2));
+        observe_post_stage(observer(), var, t + dt / 2, dt);
+
+        FLUX_TIMED(post_process, this->post_process(var, ex, t + dt));
+
+        observe_post_step(observer(), var, t + dt, dt);
+
+        t += dt;
+    }
+};
+
+// Tiled SSP-RK3, see tiled.hpp. op_L_tile(u, out, ex, t) writes L at
+// u[r + i] into out[i], r = tile_options().radius. The tiles run on several
+// threads at once, so op_L_tile gets ex as const. All stages of a tile run
+// at once, so there is no post_process_rk_stage and no stage observer.
+template <InplaceVarRequirements VarType, typename ExType>
+    requires TileableVarRequirements<VarType>
+class TiledRK3Solver : public InplaceSolver<VarType, ExType> {
+public:
+    virtual double get_dt(const VarType &var, ExType &ex, double t) const = 0;
+
+    virtual void op_L_tile(std::span<const double> u, std::span<double> out,
+                           const ExType &ex, double t) const = 0;
+
+    virtual void post_process(VarType &var, ExType &ex, double t) const {}
+
+    virtual void pre_process(VarType &var, ExType &ex, double t) const {}
+
+    virtual TileOptions tile_options() const { return {}; }
+
+    // no observer by default, see observer.hpp
+    virtual ObserverBase *observer() const { return nullptr; }
+
+    void update(VarType &var, StageBuffers<VarType> &buffers, ExType &ex,
+                double &t, bool &stop_flag, double tend) const override {
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(observer(), var, t, dt);
+
+        FLUX_TIMED(pre_process, this->pre_process(var, ex, t));
+
+        const ExType &tile_ex = ex;
+        FLUX_TIMED(op_L, tiled_ssprk3_update(
+                             var, buffers, t, dt, tile_options(),
+                             [&](std::span<const double> u,
+                                 std::span<double> out, double s) {
+                                 op_L_tile(u, out, tile_ex, s);
+                             }));
+
+        FLUX_TIMED(post_process, this->post_process(var, ex, t + dt));
+
+        observe_post_step(observer(), var, t + dt, dt);
+
+        t += dt;
+    }
+};
+
+// 2N low-storage RK, see low_storage.hpp, only var and one buffer are used.
+template <InplaceVarRequirements VarType, typename ExType, auto Tableau>
+    requires LowStorageTableauType<decltype(Tableau)>
+class LowStorageSolver : public InplaceSolver<VarType, ExType> {
+public:
+    virtual double get_dt(const VarType &var, ExType &ex, double t) const = 0;
+
+    // out = a * out + L(var)
+    virtual void op_L_acc(const VarType &var, VarType &out, double a,
+                          ExType &ex, double t) const = 0;
+
+    virtual void post_process(VarType &var, ExType &ex, double t) const {}
+
+    virtual void pre_process(VarType &var, ExType &ex, double t) const {}
+
+    virtual void post_process_rk_stage(VarType &var, ExType &ex,
+                                       double t) const {}
+
+    // no observer by default, see observer.hpp
+    virtual ObserverBase *observer() const { return nullptr; }
+
+    void update(VarType &var, StageBuffers<VarType> &buffers, ExType &ex,
+                double &t, bool &stop_flag, double tend) const override {
+        double dt = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+        if (t + dt >= tend && t < tend) {
+            dt = tend - t;
+            stop_flag = true;
+        }
+
+        observe_pre_step(observer(), var, t, dt);
+
+        FLUX_TIMED(pre_process, this->pre_process(var, ex, t));
+
+        auto &G = buffers.get(0, var);
+        low_storage_step<Tableau>(
+            var, G, t, dt,
+            [&](const VarType &v, VarType &out, double a, double s) {
+                FLUX_TIMED(op_L, op_L_acc(v, out, a, ex, s));
+            },
+            [&](VarType &v, double s) {
+                FLUX_TIMED(post_process_rk_stage,
+                           post_process_rk_stage(v, ex, s));
+                observe_post_stage(observer(), v, s, dt);
+            });
+
+        FLUX_TIMED(post_process, this->post_process(var, ex, t + dt));
+
+        observe_post_step(observer(), var, t + dt, dt);
+
+        t += dt;
+    }
+};
+
+// Adaptive contract: update(var, controller, ex, t, stop_flag, tend) takes
+// one accepted step of the size proposed by the controller, which is owned
+// by run(). get_dt is the first dt and, with cfl_limit, an upper bound.
+template <VarRequirements VarType, typename ExType>
+class AdaptiveSolver {
+public:
+    auto run(VarType var, ExType &ex, double t0,
+             double tend) const -> flux::expected<VarType, std::string> {
+        if (tend <= t0) return var;
+
+        AdaptiveController controller{adaptive_options()};
+        double t = t0;
+        bool stop_flag = false;
+        constexpr auto iter_max = std::numeric_limits<std::size_t>::max();
+        for (size_t iter = 0; iter < iter_max && (!stop_flag); ++iter) {
+            var = FLUX_TIMED_STEP(
+                t, update(var, controller, ex, t, stop_flag, tend));
+        }
+        if (controller.failed()) {
+            return flux::unexpected{std::string{"Step size too small"}};
+        }
+        if (!stop_flag) {
+            return flux::unexpected{std::string{"Iteration exceeds"}};
+        }
+
+        return var;
+    }
+
+    virtual VarType update(const VarType &var, AdaptiveController &controller,
+                           ExType &ex, double &t, bool &stop_flag,
+                           double tend) const = 0;
+
+    virtual AdaptiveOptions adaptive_options() const { return {}; }
+
+    virtual ~AdaptiveSolver() = default;
+};
+
+// SSPRK(3,3) with an embedded second order solution, see adaptive.hpp
+template <VarRequirements VarType, typename ExType>
+    requires IndexableVarRequirements<VarType>
+class AdaptiveRK3Solver : public AdaptiveSolver<VarType, ExType> {
+public:
+    virtual double get_dt(const VarType &var, ExType &ex, double t) const = 0;
+
+    virtual VarType op_L(const VarType &var, ExType &ex, double t) const = 0;
+
+    virtual VarType post_process(const VarType &var, ExType &ex,
+                                 double t) const {
+        return var;
+    }
+
+    virtual VarType pre_process(const VarType &var, ExType &ex,
+                                double t) const {
+        return var;
+    }
+
+    virtual VarType post_process_rk_stage(const VarType &var, ExType &ex,
+                                          double t) const {
+        return var;
+    }
+
+    // no observer by default, see observer.hpp
+    virtual ObserverBase *observer() const { return nullptr; }
+
+    VarType update(const VarType &var, AdaptiveController &controller,
+                   ExType &ex, double &t, bool &stop_flag,
+                   double tend) const override {
+        double dt_max = FLUX_TIMED(get_dt, get_dt(var, ex, t));
+
+        // dt of the first attempt, post_step gets the dt of the accepted one
+        observe_pre_step(observer(), var, t,
+                         std::min(controller.next_dt(dt_max), tend - t));
+
+        auto var_n = FLUX_TIMED(pre_process, this->pre_process(var, ex, t));
+
+        VarType var2 = adaptive_rk32_step(
+            var_n, controller, t, stop_flag, tend, dt_max,
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(op_L, op_L(v, ex, s));
+            },
+            [&](const VarType &v, double s) {
+                return FLUX_TIMED(post_process_rk_stage,
+                                  post_process_rk_stage(v, ex, s));
+            });
+        if (controller.failed()) return var2;
+
+        var2 = FLUX_TIMED(post_process, this->post_process(var2, ex, t));
+
+        observe_post_step(observer(), var2, t, controller.last_dt());
+        return var2;
+    }
 };
 }  // namespace flux::solver_virtual
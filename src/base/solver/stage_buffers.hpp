@@ -0,0 +1,35 @@
+#pragma once
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+
+namespace flux {
+
+// Scratch states of the in-place updaters. run() owns one StageBuffers and
+// passes it to every update(), a buffer is created on its first use only, so
+// after the first step no state is allocated any more.
+template <typename VarType>
+class StageBuffers {
+public:
+    // i-th buffer, copied from `like` if it does not exist yet
+    VarType &get(std::size_t i, const VarType &like) {
+        while (m_buffers.size() <= i) { m_buffers.push_back(like); }
+        return m_buffers[i];
+    }
+
+    std::size_t size() const { return m_buffers.size(); }
+
+    // scratch of the updater that is not a state, e.g. TileWorkspace, created
+    // on first use as the buffers; every call must ask for the same T
+    template <typename T>
+    T &workspace() {
+        if (m_workspace == nullptr) { m_workspace = std::make_shared<T>(); }
+        return *static_cast<T *>(m_workspace.get());
+    }
+
+private:
+    std::deque<VarType> m_buffers;  // references stay valid on push_back
+    std::shared_ptr<void> m_workspace;
+};
+}  // namespace flux
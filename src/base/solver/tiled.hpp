@@ -0,0 +1,307 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <concepts>
+#include <cstddef>
+#include <functional>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "parallel/parallel_for.hpp"
+#include "parallel/task_graph.hpp"
+#include "profiler.hpp"
+#include "stage_buffers.hpp"
+
+namespace flux {
+
+// the tiles read VarType through as_span and write it element by element
+template <typename T>
+concept TileableVarRequirements =
+    requires(T &a, const T &c, std::size_t i, double d) {
+        { c.size() } -> std::convertible_to<std::size_t>;
+        { as_span(c) } -> std::convertible_to<std::span<const double>>;
+        a[i] = d;
+    };
+
+// Temporal: every tile runs through all stages at once, the tile edges are
+// computed twice, see tiled_ssprk3_step.
+// TaskGraph: one task per block and stage, the stages of neighbouring blocks
+// overlap, nothing is computed twice, see task_graph_ssprk3_step.
+enum class TileSchedule { Temporal, TaskGraph };
+
+struct TileOptions {
+    // cells one evaluation of L reads on each side of a cell, 3 for WENO5
+    std::size_t radius = 3;
+
+    // owned cells of a tile, the stage values of a tile should fit in L2
+    std::size_t cells = 4096;
+
+    TileSchedule schedule = TileSchedule::Temporal;
+
+    // nullptr means ThreadPool::global()
+    ThreadPool *pool = nullptr;
+};
+
+// Scratch of the tiled steps, owned by run() through
+// StageBuffers::workspace() and reused by every step.
+class TileWorkspace {
+public:
+    // at least num arrays of size values, called before the parallel loop
+    void resize_scratch(std::size_t num, std::size_t size) {
+        if (m_scratch.size() < num) { m_scratch.resize(num); }
+        for (auto &scratch : m_scratch) {
+            if (scratch.size() < size) {
+                FLUX_COUNT_ALLOCATION();
+                scratch.resize(size);
+            }
+        }
+    }
+
+    std::span<double> scratch(std::size_t k) { return m_scratch[k]; }
+
+    // stage(s, b, lo, hi, boundary) of task_graph_ssprk3_step, set for the
+    // current step and called by the tasks of graph()
+    using StageFunc = std::function<void(std::size_t, std::size_t, std::size_t,
+                                         std::size_t, bool)>;
+
+    void set_stage(StageFunc stage) { m_stage = std::move(stage); }
+
+    void stage(std::size_t s, std::size_t b, std::size_t lo, std::size_t hi,
+               bool boundary) const {
+        m_stage(s, b, lo, hi, boundary);
+    }
+
+    // the task graph of a block layout, build(graph) is called on first use
+    // and whenever the layout changes
+    template <typename BuildType>
+    TaskGraph &graph(const std::array<std::size_t, 3> &layout,
+                     const BuildType &build) {
+        if (layout != m_layout) {
+            FLUX_COUNT_ALLOCATION();
+            m_graph = TaskGraph{};
+            build(m_graph);
+            m_layout = layout;
+        }
+        return m_graph;
+    }
+
+private:
+    std::vector<std::vector<double>> m_scratch;  // one per block of tiles
+    StageFunc m_stage;
+    TaskGraph m_graph;
+    std::array<std::size_t, 3> m_layout{};
+};
+
+// One SSP-RK3 step on a periodic 1D grid with temporal tiling, next is set
+// to the state after the step. A tile of owned cells [a, b) copies the cells
+// [a - 3r, b + 3r) and advances them through all three stages while they are
+// in cache, every stage shrinks the valid range by r on each side:
+//   stage 1 on [a - 2r, b + 2r), stage 2 on [a - r, b + r), stage 3 on [a, b)
+// so only 3r cells per tile edge are computed twice, instead of three sweeps
+// over the whole state per stage.
+//
+// op_tile(u, out, s) writes L at u[r + i] into out[i], u.size() is
+// out.size() + 2r. The stages combine as in RK3InplaceSolver, so with an
+// op_tile computing the same as op_L the result is bitwise identical.
+template <TileableVarRequirements VarType, typename OpTileType>
+void tiled_ssprk3_step(const VarType &var, VarType &next,
+                       TileWorkspace &workspace, double t, double dt,
+                       const TileOptions &options, const OpTileType &op_tile) {
+    std::size_t n = var.size();
+    if (n == 0) return;
+
+    std::size_t r = options.radius;
+    std::size_t cells = std::max<std::size_t>(options.cells, 1);
+    std::size_t num_tiles = (n + cells - 1) / cells;
+
+    // contiguous runs of tiles per thread, as the cell loops, each run works
+    // in its own scratch
+    ParallelOptions loop_options{.grain = 2, .pool = options.pool};
+    auto &pool = detail::pool_of(loop_options);
+    auto [run_size, num_runs] =
+        detail::block_layout(num_tiles, loop_options, pool);
+    workspace.resize_scratch(num_runs, 4 * std::min(cells, n) + 16 * r);
+
+    auto tile_step = [&](std::size_t tile, std::span<double> scratch) {
+        std::size_t first = tile * cells;
+        std::size_t m = std::min(first + cells, n) - first;
+
+        auto w0 = scratch.first(m + 6 * r);
+        auto w1 = scratch.subspan(m + 6 * r, m + 4 * r);
+        auto w2 = scratch.subspan(2 * m + 10 * r, m + 2 * r);
+        auto k = scratch.subspan(3 * m + 12 * r, m + 4 * r);
+
+        // u[first - 3r + j], periodic
+        auto u = as_span(var);
+        std::size_t start = (first + n - (3 * r) % n) % n;
+        for (std::size_t j = 0; j < w0.size(); j++) {
+            w0[j] = u[(start + j) % n];
+        }
+
+        op_tile(std::span<const double>{w0}, k.first(m + 4 * r), t);
+        for (std::size_t j = 0; j < m + 4 * r; j++) {
+            w1[j] = w0[j + r] + dt * k[j];
+        }
+
+        op_tile(std::span<const double>{w1}, k.first(m + 2 * r), t + dt);
+        for (std::size_t j = 0; j < m + 2 * r; j++) {
+            w2[j] = (3.0 / 4) * w0[j + 2 * r]
+                    + (1.0 / 4) * (w1[j + r] + dt * k[j]);
+        }
+
+        op_tile(std::span<const double>{w2}, k.first(m), t + dt / 2);
+        for (std::size_t j = 0; j < m; j++) {
+            next[first + j] = (1.0 / 3) * w0[j + 3 * r]
+                              + (2.0 / 3) * (w2[j + r] + dt * k[j]);
+        }
+    };
+
+    pool.run_pinned(num_runs, [&](std::size_t run) {
+        auto scratch = workspace.scratch(run);
+        std::size_t last = std::min((run + 1) * run_size, num_tiles);
+        for (std::size_t tile = run * run_size; tile < last; tile++) {
+            tile_step(tile, scratch);
+        }
+    });
+}
+
+// One SSP-RK3 step as a task graph over blocks of at least options.cells
+// cells. Every stage of a block is split in two tasks:
+//   interior: the cells radius away from the block ends, reads only the
+//             block, so it can start as soon as the block finished the
+//             previous stage
+//   boundary: the radius cells at both ends, also reads the neighbours
+// so the interior of a block overlaps the boundaries of its neighbours and a
+// block starts the next stage without waiting for the whole state. The stage
+// values are kept in w1 and w2, the result in next; every cell is computed
+// once and combined as in RK3InplaceSolver, the results are bitwise the same.
+// The graph and the scratch of the blocks are kept in workspace, so they are
+// only built in the first step.
+template <TileableVarRequirements VarType, typename OpTileType>
+void task_graph_ssprk3_step(const VarType &var, VarType &w1, VarType &w2,
+                            VarType &next, TileWorkspace &workspace, double t,
+                            double dt, const TileOptions &options,
+                            const OpTileType &op_tile) {
+    std::size_t n = var.size();
+    if (n == 0) return;
+
+    // blocks of at least radius cells, so the halo is in the neighbours
+    std::size_t r = options.radius;
+    std::size_t block = std::max({options.cells, r, std::size_t{1}});
+    std::size_t num_blocks = std::max<std::size_t>(n / block, 1);
+    auto begin = [&](std::size_t b) { return b * n / num_blocks; };
+
+    // the scratch of a block holds L of the interior task, then L and the
+    // halo of the boundary task, the two may run at the same time
+    std::size_t max_len = (n + num_blocks - 1) / num_blocks;
+    workspace.resize_scratch(num_blocks, max_len + 4 * r);
+
+    // stage s reads inputs[s] and writes outputs[s]
+    std::array<const VarType *, 3> inputs{&var, &w1, &w2};
+    std::array<VarType *, 3> outputs{&w1, &w2, &next};
+    std::array<double, 3> times{t, t + dt, t + dt / 2};
+
+    // L on the cells [lo, hi) of block b at stage s, combined into
+    // outputs[s]
+    auto stage = [&](std::size_t s, std::size_t b, std::size_t lo,
+                     std::size_t hi, bool boundary) {
+        if (lo >= hi) return;
+        std::size_t m = hi - lo;
+        auto u = as_span(*inputs[s]);
+        auto scratch = workspace.scratch(b);
+        auto L = boundary ? scratch.subspan(max_len, m) : scratch.first(m);
+        if (boundary) {
+            // u[lo - r + j], periodic
+            auto halo = scratch.subspan(max_len + r, m + 2 * r);
+            std::size_t start = (lo + n - r % n) % n;
+            for (std::size_t j = 0; j < halo.size(); j++) {
+                halo[j] = u[(start + j) % n];
+            }
+            op_tile(std::span<const double>{halo}, L, times[s]);
+        } else {
+            op_tile(u.subspan(lo - r, m + 2 * r), L, times[s]);
+        }
+
+        auto u0 = as_span(var);
+        auto &out = *outputs[s];
+        for (std::size_t j = 0; j < m; j++) {
+            std::size_t i = lo + j;
+            if (s == 0) {
+                out[i] = u0[i] + dt * L[j];
+            } else if (s == 1) {
+                out[i] = (3.0 / 4) * u0[i] + (1.0 / 4) * (u[i] + dt * L[j]);
+            } else {
+                out[i] = (1.0 / 3) * u0[i] + (2.0 / 3) * (u[i] + dt * L[j]);
+            }
+        }
+    };
+
+    // the graph only depends on the layout, it is built once and its tasks
+    // call the stage of the current step
+    auto build = [&](TaskGraph &graph) {
+        auto interior = std::vector<TaskGraph::Node>(3 * num_blocks);
+        auto boundary = std::vector<TaskGraph::Node>(3 * num_blocks);
+        for (std::size_t s = 0; s < 3; s++) {
+            for (std::size_t b = 0; b < num_blocks; b++) {
+                std::size_t a = begin(b);
+                std::size_t e = begin(b + 1);
+                std::size_t mid_lo = std::min(a + r, e);
+                std::size_t mid_hi = std::max(e - std::min(r, e - a), mid_lo);
+                std::size_t k = s * num_blocks + b;
+                interior[k] = graph.add(
+                    [&workspace, s, b, mid_lo, mid_hi]() {
+                        workspace.stage(s, b, mid_lo, mid_hi, false);
+                    });
+                boundary[k] = graph.add(
+                    [&workspace, s, b, a, e, mid_lo, mid_hi]() {
+                        workspace.stage(s, b, a, mid_lo, true);
+                        workspace.stage(s, b, mid_hi, e, true);
+                    });
+                if (s == 0) continue;
+
+                // the previous stage of the block, and of the neighbouring
+                // boundaries the halo is read from
+                std::size_t prev = k - num_blocks;
+                std::size_t left = (s - 1) * num_blocks
+                                   + (b + num_blocks - 1) % num_blocks;
+                std::size_t right =
+                    (s - 1) * num_blocks + (b + 1) % num_blocks;
+                graph.depend(interior[k], interior[prev]);
+                graph.depend(interior[k], boundary[prev]);
+                graph.depend(boundary[k], interior[prev]);
+                graph.depend(boundary[k], boundary[prev]);
+                graph.depend(boundary[k], boundary[left]);
+                graph.depend(boundary[k], boundary[right]);
+            }
+        }
+    };
+
+    // [&stage] is small enough for std::function not to allocate
+    workspace.set_stage([&stage](std::size_t s, std::size_t b, std::size_t lo,
+                                 std::size_t hi, bool boundary) {
+        stage(s, b, lo, hi, boundary);
+    });
+    auto &graph = workspace.graph({n, r, block}, build);
+    graph.run(options.pool != nullptr ? *options.pool : ThreadPool::global());
+    workspace.set_stage(nullptr);
+}
+
+// one step of the tiled updaters with options.schedule, var is replaced by
+// the state after the step
+template <TileableVarRequirements VarType, typename OpTileType>
+void tiled_ssprk3_update(VarType &var, StageBuffers<VarType> &buffers,
+                         double t, double dt, const TileOptions &options,
+                         const OpTileType &op_tile) {
+    auto &next = buffers.get(0, var);
+    auto &workspace = buffers.template workspace<TileWorkspace>();
+    if (options.schedule == TileSchedule::TaskGraph) {
+        task_graph_ssprk3_step(var, buffers.get(1, var), buffers.get(2, var),
+                               next, workspace, t, dt, options, op_tile);
+    } else {
+        tiled_ssprk3_step(var, next, workspace, t, dt, options, op_tile);
+    }
+    std::swap(var, next);
+}
+}  // namespace flux
@@ -0,0 +1,404 @@
+#pragma once
+
+#include <array>
+#include <cassert>
+#include <concepts>
+#include <cstddef>
+#include <cstdint>
+#include <numeric>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "parallel/parallel_for.hpp"
+#include "simd.hpp"
+#include "weno5.hpp"
+
+namespace flux {
+
+// Coefficients of the WENO reconstruction of odd order 2r - 1 from r
+// candidate stencils of r cells, for a cell size of 1. Stencil k of cell i is
+// the cells i - r + 1 + k to i + k, u_j below is its cell j.
+template <std::size_t Order>
+struct WenoCoefficients {
+    static constexpr std::size_t r = (Order + 1) / 2;
+    using Row = std::array<double, r>;
+
+    // candidate k at the left and right face of the cell: sum_j c[k][j] u_j
+    std::array<Row, r> left;
+    std::array<Row, r> right;
+
+    // linear weights, with them the candidates are the reconstruction of
+    // order 2r - 1 from all 2r - 1 cells
+    Row d_left;
+    Row d_right;
+
+    // smoothness indicator of stencil k (Jiang, Shu): the sum over the
+    // derivatives l = 1 to r - 1 of the candidate polynomial p of
+    //   int (p^(l))^2 dx = sum_j u_j sum_l>=j beta[k][j][l] u_l
+    // on the cell i
+    std::array<std::array<Row, r>, r> beta;
+};
+
+namespace detail {
+// exact fractions, a coefficient that overflows does not compile
+struct Rational {
+    std::int64_t num = 0;
+    std::int64_t den = 1;
+
+    constexpr Rational() = default;
+
+    // NOLINTNEXTLINE(google-explicit-constructor,hicpp-explicit-conversions)
+    constexpr Rational(std::int64_t n, std::int64_t d = 1) : num(n), den(d) {
+        if (d == 0) throw std::domain_error("zero denominator");
+        std::int64_t g = std::gcd(n, d);
+        if (d < 0) g = -g;
+        num /= g;
+        den /= g;
+    }
+
+    [[nodiscard]] constexpr double value() const {
+        return static_cast<double>(num) / static_cast<double>(den);
+    }
+
+    // reduced before multiplying, the intermediate values stay small
+    friend constexpr Rational operator+(Rational a, Rational b) {
+        std::int64_t g = std::gcd(a.den, b.den);
+        return {a.num * (b.den / g) + b.num * (a.den / g), a.den / g * b.den};
+    }
+
+    friend constexpr Rational operator-(Rational a, Rational b) {
+        return a + Rational{-b.num, b.den};
+    }
+
+    friend constexpr Rational operator*(Rational a, Rational b) {
+        std::int64_t g1 = std::gcd(a.num, b.den);
+        std::int64_t g2 = std::gcd(b.num, a.den);
+        if (g1 == 0 || g2 == 0) return {};  // a zero
+        return {(a.num / g1) * (b.num / g2), (a.den / g2) * (b.den / g1)};
+    }
+
+    friend constexpr Rational operator/(Rational a, Rational b) {
+        return a * Rational{b.den, b.num};
+    }
+
+    friend constexpr bool operator==(Rational a, Rational b) = default;
+};
+
+// coefficients of x^0 to x^N-1
+template <std::size_t N>
+using Polynomial = std::array<Rational, N>;
+
+// the polynomials are taken by value, GCC may construct the result of
+// p = f(p) in p while f still reads it
+
+template <std::size_t N>
+constexpr Polynomial<N> derivative(Polynomial<N> p) {
+    Polynomial<N> dp{};
+    for (std::size_t i = 1; i < N; i++) {
+        dp[i - 1] = p[i] * static_cast<std::int64_t>(i);
+    }
+    return dp;
+}
+
+// p (x - root) / (x_m - root), p of degree below N - 1
+template <std::size_t N>
+constexpr Polynomial<N> lagrange_factor(Polynomial<N> p, Rational root,
+                                        Rational x_m) {
+    Rational scale = Rational{1} / (x_m - root);
+    Polynomial<N> res{};
+    res[0] = Rational{0} - root * p[0] * scale;
+    for (std::size_t i = 1; i < N; i++) {
+        res[i] = (p[i - 1] - root * p[i]) * scale;
+    }
+    return res;
+}
+
+template <std::size_t N>
+constexpr Rational evaluate(const Polynomial<N> &p, Rational x) {
+    Rational res = 0;
+    for (std::size_t i = N; i > 0; i--) { res = res * x + p[i - 1]; }
+    return res;
+}
+
+// integral of p * q on the cell [-1/2, 1/2]
+template <std::size_t N>
+constexpr Rational cell_integral(const Polynomial<N> &p,
+                                 const Polynomial<N> &q) {
+    // int x^m = 1 / (2^m (m + 1)) for even m, 0 for odd m
+    Rational res = 0;
+    for (std::size_t i = 0; i < N; i++) {
+        for (std::size_t j = i % 2; j < N; j += 2) {
+            std::size_t m = i + j;
+            auto scale = static_cast<std::int64_t>((m + 1) << m);
+            res = res + p[i] * q[j] / scale;
+        }
+    }
+    return res;
+}
+
+// phi_j of the polynomial p = sum_j u_j phi_j of degree N - 1 with the means
+// u_j on the cells first to first + N - 1, the cell first + j being
+// [first + j - 1/2, first + j + 1/2]
+template <std::size_t N>
+constexpr std::array<Polynomial<N>, N> cell_mean_basis(std::int64_t first) {
+    // the primitive P of p interpolates sum_j<m u_j at the cell ends x_m
+    std::array<Rational, N + 1> x{};
+    for (std::size_t m = 0; m <= N; m++) {
+        x[m] = Rational{2 * (first + static_cast<std::int64_t>(m)) - 1, 2};
+    }
+
+    // the derivatives of the Lagrange polynomials of x_m, of degree N
+    std::array<Polynomial<N + 1>, N + 1> dl{};
+    for (std::size_t m = 1; m <= N; m++) {
+        Polynomial<N + 1> lagrange{};
+        lagrange[0] = 1;
+        for (std::size_t q = 0; q <= N; q++) {
+            if (q != m) lagrange = lagrange_factor(lagrange, x[q], x[m]);
+        }
+        dl[m] = derivative(lagrange);
+    }
+
+    // p = P' = sum_m P(x_m) L_m'
+    std::array<Polynomial<N>, N> phi{};
+    for (std::size_t j = 0; j < N; j++) {
+        for (std::size_t i = 0; i < N; i++) {
+            Rational sum = 0;
+            for (std::size_t m = j + 1; m <= N; m++) { sum = sum + dl[m][i]; }
+            phi[j][i] = sum;
+        }
+    }
+    return phi;
+}
+
+template <std::size_t Order>
+constexpr WenoCoefficients<Order> make_weno_coefficients() {
+    static_assert(Order % 2 == 1 && Order >= 3, "odd orders from 3");
+    constexpr std::size_t r = (Order + 1) / 2;
+    constexpr auto shift = static_cast<std::int64_t>(r) - 1;
+
+    // the candidates c and linear weights d at the face x
+    using Row = typename WenoCoefficients<Order>::Row;
+    auto faces = [](Rational x, std::array<Row, r> &c, Row &d) {
+        auto all = cell_mean_basis<Order>(-shift);
+        std::array<std::array<Rational, r>, r> cand{};
+        for (std::size_t k = 0; k < r; k++) {
+            auto phi = cell_mean_basis<r>(static_cast<std::int64_t>(k) - shift);
+            for (std::size_t j = 0; j < r; j++) {
+                cand[k][j] = evaluate(phi[j], x);
+                c[k][j] = cand[k][j].value();
+            }
+        }
+
+        // the cell t of all cells is the cell t - k of stencil k:
+        //   sum_k d_k cand[k][t - k] = evaluate(all[t], x)
+        // triangular for t < r, the other cells are a check
+        std::array<Rational, r> weights{};
+        for (std::size_t t = 0; t < Order; t++) {
+            Rational sum = 0;
+            for (std::size_t k = t < r ? 0 : t - r + 1; k < t && k < r; k++) {
+                sum = sum + weights[k] * cand[k][t - k];
+            }
+            Rational target = evaluate(all[t], x);
+            if (t < r) {
+                weights[t] = (target - sum) / cand[t][0];
+            } else if (sum != target) {
+                throw std::logic_error("no linear weights");
+            }
+        }
+        for (std::size_t k = 0; k < r; k++) { d[k] = weights[k].value(); }
+    };
+
+    WenoCoefficients<Order> c{};
+    faces(Rational{-1, 2}, c.left, c.d_left);
+    faces(Rational{1, 2}, c.right, c.d_right);
+
+    for (std::size_t k = 0; k < r; k++) {
+        // the derivatives 1 to r - 1 of the candidate
+        std::array<std::array<Polynomial<r>, r>, r> derivatives{};
+        derivatives[0] =
+            cell_mean_basis<r>(static_cast<std::int64_t>(k) - shift);
+        for (std::size_t l = 1; l < r; l++) {
+            for (std::size_t j = 0; j < r; j++) {
+                derivatives[l][j] = derivative(derivatives[l - 1][j]);
+            }
+        }
+
+        for (std::size_t i = 0; i < r; i++) {
+            for (std::size_t j = i; j < r; j++) {
+                Rational b = 0;
+                for (std::size_t l = 1; l < r; l++) {
+                    b = b + cell_integral(derivatives[l][i], derivatives[l][j]);
+                }
+
+                // u_i u_j appears twice for i != j
+                c.beta[k][i][j] = (i == j ? b : b * 2).value();
+            }
+        }
+    }
+    return c;
+}
+}  // namespace detail
+
+template <std::size_t Order>
+inline constexpr WenoCoefficients<Order> weno_coefficients =
+    detail::make_weno_coefficients<Order>();
+
+// weights of r stencils, WenoJS and WenoM
+template <typename Policy, std::size_t R>
+concept WenoWeightsRequirements = requires(const std::array<double, R> &b) {
+    { Policy::weights(b, b) } -> std::same_as<std::array<double, R>>;
+};
+
+namespace detail {
+template <std::size_t Order, typename T>
+auto weno_smoothness(const std::array<T, Order> &v) {
+    constexpr auto &c = weno_coefficients<Order>;
+    constexpr std::size_t r = c.r;
+    std::array<T, r> b;
+    for (std::size_t k = 0; k < r; k++) {
+        b[k] = 0.0;
+        for (std::size_t i = 0; i < r; i++) {
+            T s = c.beta[k][i][i] * v[k + i];
+            for (std::size_t j = i + 1; j < r; j++) {
+                s = s + c.beta[k][i][j] * v[k + j];
+            }
+            b[k] = b[k] + v[k + i] * s;
+        }
+    }
+    return b;
+}
+
+template <typename Policy, std::size_t Order, typename T, typename Table>
+T weno_combine(const std::array<T, Order> &v,
+               const std::array<T, (Order + 1) / 2> &b, const Table &cand,
+               const std::array<double, (Order + 1) / 2> &d) {
+    auto w = Policy::weights(b, d);
+    T res = 0.0;
+    for (std::size_t k = 0; k < w.size(); k++) {
+        T u = cand[k][0] * v[k];
+        for (std::size_t j = 1; j < w.size(); j++) {
+            u = u + cand[k][j] * v[k + j];
+        }
+        res = res + w[k] * u;
+    }
+    return res;
+}
+}  // namespace detail
+
+// WENO of the given odd order in the cell of v[Order / 2], from the Order
+// cells around it, e.g. weno_faces<7>(v) for WENO7, weno_faces<5> is weno5
+// up to rounding. T = Pack reconstructs Pack::width consecutive cells.
+template <std::size_t Order, typename Policy = WenoJS, typename T>
+    requires WenoWeightsRequirements<Policy, (Order + 1) / 2>
+Weno5Faces<T> weno_faces(const std::array<T, Order> &v) {
+    constexpr auto &c = weno_coefficients<Order>;
+    auto b = detail::weno_smoothness(v);
+    return {detail::weno_combine<Policy>(v, b, c.left, c.d_left),
+            detail::weno_combine<Policy>(v, b, c.right, c.d_right)};
+}
+
+// only the left face, see weno5_left_face
+template <std::size_t Order, typename Policy = WenoJS, typename T>
+    requires WenoWeightsRequirements<Policy, (Order + 1) / 2>
+T weno_left_face(const std::array<T, Order> &v) {
+    constexpr auto &c = weno_coefficients<Order>;
+    return detail::weno_combine<Policy>(v, detail::weno_smoothness(v), c.left,
+                                        c.d_left);
+}
+
+// only the right face, see weno5_right_face
+template <std::size_t Order, typename Policy = WenoJS, typename T>
+    requires WenoWeightsRequirements<Policy, (Order + 1) / 2>
+T weno_right_face(const std::array<T, Order> &v) {
+    constexpr auto &c = weno_coefficients<Order>;
+    return detail::weno_combine<Policy>(v, detail::weno_smoothness(v),
+                                        c.right, c.d_right);
+}
+
+namespace detail {
+// the Order values from v(j), v(j + 1), ...
+template <std::size_t Order, typename LoadType>
+auto weno_stencil(const LoadType &load, std::size_t j) {
+    std::array<decltype(load(j)), Order> v;
+    for (std::size_t i = 0; i < Order; i++) { v[i] = load(j + i); }
+    return v;
+}
+}  // namespace detail
+
+// as weno5_halo with Order / 2 ghost cells on each side: u[i + Order / 2] is
+// cell i, u.size() is ul.size() + Order - 1
+template <std::size_t Order, typename Policy = WenoJS>
+void weno_halo(std::span<const double> u, std::span<double> ul,
+               std::span<double> ur, const ParallelOptions &options = {}) {
+    std::size_t n = ul.size();
+    assert(ur.size() == n && u.size() == n + Order - 1);
+
+    using P = Pack<>;
+    std::size_t num_packs = n / P::width;
+    parallel_for(
+        0, num_packs,
+        [&](std::size_t k) {
+            std::size_t i = k * P::width;
+            auto load = [&](std::size_t j) { return P::load(u.data() + j); };
+            auto faces = weno_faces<Order, Policy>(
+                detail::weno_stencil<Order>(load, i));
+            faces.ul.store(ul.data() + i);
+            faces.ur.store(ur.data() + i);
+        },
+        options);
+
+    auto load_one = [&](std::size_t j) { return u[j]; };
+    for (std::size_t i = num_packs * P::width; i < n; i++) {
+        auto faces = weno_faces<Order, Policy>(
+            detail::weno_stencil<Order>(load_one, i));
+        ul[i] = faces.ul;
+        ur[i] = faces.ur;
+    }
+}
+
+// as weno5 on a periodic array
+template <std::size_t Order, typename Policy = WenoJS>
+void weno(const std::vector<double> &u, std::vector<double> &res_ul,
+          std::vector<double> &res_ur) {
+    constexpr std::size_t g = Order / 2;
+    std::size_t n = u.size();
+    res_ul.resize(n);
+    res_ur.resize(n);
+
+    // the cells [g, n - g) have their stencil in u
+    if (n > 2 * g) {
+        weno_halo<Order, Policy>(
+            u, std::span<double>{res_ul}.subspan(g, n - 2 * g),
+            std::span<double>{res_ur}.subspan(g, n - 2 * g));
+    }
+
+    // near the ends the stencil wraps around
+    auto cell = [&](std::size_t i) {
+        auto load = [&](std::size_t j) { return u[(j + g * n - g) % n]; };
+        auto faces =
+            weno_faces<Order, Policy>(detail::weno_stencil<Order>(load, i));
+        res_ul[i] = faces.ul;
+        res_ur[i] = faces.ur;
+    };
+    for (std::size_t i = 0; i < std::min(n, g); i++) { cell(i); }
+    for (std::size_t i = std::max(n, 2 * g) - g; i < n; i++) { cell(i); }
+}
+
+// as weno5_fd_lf with the reconstructions of the given order
+template <std::size_t Order, typename Policy = WenoJS, typename FluxType>
+void weno_fd_lf(std::span<const double> u, double c, const FluxType &f,
+                double dx, std::span<double> L) {
+    // fhat at face k - 1/2 from the padded cells k .. k + Order
+    auto face = [](const auto &load, const auto &fp, const auto &fm,
+                   std::size_t k) {
+        auto load_fp = [&](std::size_t j) { return load(fp, j); };
+        auto load_fm = [&](std::size_t j) { return load(fm, j); };
+        return weno_right_face<Order, Policy>(
+                   detail::weno_stencil<Order>(load_fp, k))
+               + weno_left_face<Order, Policy>(
+                   detail::weno_stencil<Order>(load_fm, k + 1));
+    };
+    detail::fd_lf<Order / 2 + 1>(u, c, f, dx, L, face);
+}
+}  // namespace flux
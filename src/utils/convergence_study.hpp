@@ -0,0 +1,128 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iostream>
+#include <numeric>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "error_and_order.hpp"
+#include "parallel/thread_pool.hpp"
+
+namespace flux {
+
+// errors of one numerical solution against the reference solution
+struct ErrorNorms {
+    double l1 = 0;
+    double l2 = 0;
+    double linf = 0;
+};
+
+inline ErrorNorms error_norms(const std::vector<double> &uh,
+                              const std::vector<double> &u, double dx) {
+    return {error(uh, u, dx, ErrorType::L1), error(uh, u, dx, ErrorType::L2),
+            error(uh, u, dx, ErrorType::Linf)};
+}
+
+// errors and orders of one scheme over all resolutions
+struct ConvergenceTable {
+    std::string name;
+    std::vector<size_t> nlist;
+    std::vector<double> error_l1;
+    std::vector<double> error_l2;
+    std::vector<double> error_linf;
+    std::vector<double> order_l1;
+    std::vector<double> order_l2;
+    std::vector<double> order_linf;
+
+    void print(std::ostream &out, char delimiter) const {
+        print_error_table(out, nlist, error_l1, error_l2, error_linf, order_l1,
+                          order_l2, order_linf, delimiter);
+    }
+
+    void print_to_file(const std::string &file_name, char delimiter) const {
+        print_error_table_to_file(file_name, nlist, error_l1, error_l2,
+                                  error_linf, order_l1, order_l2, order_linf,
+                                  delimiter);
+    }
+};
+
+// Runs every scheme at every resolution concurrently:
+//   auto study = ConvergenceStudy{cfg.nlist};
+//   study.add("godunov", [=](size_t n) { ... return error_norms(uh, u, dx); });
+//   for (const auto &table : study.run()) { table.print(std::cout, ' '); }
+// A case runs concurrently with the others, so it must not share mutable
+// state with them, e.g. it should copy the solver.
+class ConvergenceStudy {
+public:
+    using Case = std::function<ErrorNorms(size_t n)>;
+
+    // pool nullptr means ThreadPool::global()
+    explicit ConvergenceStudy(std::vector<size_t> nlist,
+                              ThreadPool *pool = nullptr)
+        : m_nlist(std::move(nlist)), m_pool(pool) {}
+
+    ConvergenceStudy &add(std::string name, Case func) {
+        m_schemes.push_back({std::move(name), std::move(func)});
+        return *this;
+    }
+
+    // one table per scheme in the order of add(), the first exception thrown
+    // by a case is rethrown here
+    std::vector<ConvergenceTable> run() const {
+        size_t num_n = m_nlist.size();
+        size_t num_cases = m_schemes.size() * num_n;
+        auto errors = std::vector<ErrorNorms>(num_cases);
+
+        // case c is scheme c / num_n at resolution c % num_n, the wall time is
+        // dominated by the finest grids, so they are started first and the
+        // coarse ones fill up the idle threads
+        auto cases = std::vector<size_t>(num_cases);
+        std::iota(cases.begin(), cases.end(), 0);
+        std::stable_sort(cases.begin(), cases.end(), [&](size_t a, size_t b) {
+            return m_nlist[a % num_n] > m_nlist[b % num_n];
+        });
+
+        auto &pool = m_pool != nullptr ? *m_pool : ThreadPool::global();
+        std::atomic<size_t> next{0};
+        pool.run(std::min(pool.size(), num_cases), [&](size_t) {
+            for (size_t k = next++; k < num_cases; k = next++) {
+                size_t c = cases[k];
+                errors[c] = m_schemes[c / num_n].func(m_nlist[c % num_n]);
+            }
+        });
+
+        auto result = std::vector<ConvergenceTable>{};
+        for (size_t s = 0; s < m_schemes.size(); s++) {
+            auto table = ConvergenceTable{};
+            table.name = m_schemes[s].name;
+            table.nlist = m_nlist;
+            for (size_t i = 0; i < num_n; i++) {
+                const auto &e = errors[s * num_n + i];
+                table.error_l1.push_back(e.l1);
+                table.error_l2.push_back(e.l2);
+                table.error_linf.push_back(e.linf);
+            }
+            table.order_l1 = order(table.error_l1, m_nlist);
+            table.order_l2 = order(table.error_l2, m_nlist);
+            table.order_linf = order(table.error_linf, m_nlist);
+            result.push_back(std::move(table));
+        }
+        return result;
+    }
+
+private:
+    struct Scheme {
+        std::string name;
+        Case func;
+    };
+
+    std::vector<size_t> m_nlist;
+    std::vector<Scheme> m_schemes;
+    ThreadPool *m_pool;
+};
+}  // namespace flux
@@ -1,11 +1,14 @@
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <fstream>
 #include <iostream>
 #include <vector>
 
+#include "parallel/parallel_reduce.hpp"
+
 #if __has_include(<format>)
 #include <format>
 #define USE_FORMAT
@@ -20,28 +23,26 @@ enum class ErrorType { Linf = 0, L1, L2 };
 inline double error(const std::vector<double> &u1,
                     const std::vector<double> &u2, double dx,
                     ErrorType error_type) {
+    // checked before any pool work, so exit() does not race with the loops
     size_t len = u1.size();
     if (u2.size() != len) {
         std::cerr << "error: u1 and u2 have different length" << std::endl;
         exit(1);
     }
 
-    double result = 0;
-    for (size_t i = 0; i < len; ++i) {
-        double tmp = std::abs(u1[i] - u2[i]);
-
-        if (error_type == ErrorType::Linf) {
-            if (tmp > result) result = tmp;
-        }
-
-        if (error_type == ErrorType::L1) { result += tmp * dx; }
-
-        if (error_type == ErrorType::L2) { result += tmp * tmp * dx; }
+    // fixed summation tree, bitwise the same for any number of threads
+    auto diff = [&](size_t i) { return std::abs(u1[i] - u2[i]); };
+    switch (error_type) {
+    case ErrorType::L1:
+        return parallel_sum(
+            0, len, [&](size_t i) { return diff(i) * dx; }, Summation::Kahan);
+    case ErrorType::L2:
+        return std::sqrt(parallel_sum(
+            0, len, [&](size_t i) { return diff(i) * diff(i) * dx; },
+            Summation::Kahan));
+    default:
+        return std::max(parallel_max(0, len, diff), 0.0);
     }
-
-    if (error_type == ErrorType::L2) { result = std::sqrt(result); }
-
-    return result;
 }
 
 inline std::vector<double> order(const std::vector<double> &error,
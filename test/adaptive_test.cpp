@@ -0,0 +1,145 @@
+#include "solver/adaptive.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_stdfunc.hpp"
+#include "solver/solver_template.hpp"
+#include "solver/solver_virtual.hpp"
+
+#include "gtest/gtest.h"
+#include "test_problems.hpp"
+
+#include <cmath>
+#include <limits>
+
+using namespace flux;                 // NOLINT
+using namespace flux::test_problems;  // NOLINT
+
+namespace {
+// u' = -u^2, ex.dx is the loose stability limit returned by get_dt
+class AdaptiveC : public solver_crtp::AdaptiveRK3Solver<Vec, Mesh1d, AdaptiveC> {
+public:
+    AdaptiveOptions options;
+
+    AdaptiveOptions adaptive_options() const { return options; }
+
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return ode_dt(var, ex, t);
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        return quadratic_L(var, ex, t);
+    }
+};
+
+class AdaptiveV : public solver_virtual::AdaptiveRK3Solver<Vec, Mesh1d> {
+public:
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const override {
+        return ode_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const override {
+        return quadratic_L(var, ex, t);
+    }
+};
+
+class BlowUpC : public solver_crtp::AdaptiveRK3Solver<Vec, Mesh1d, BlowUpC> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return ode_dt(var, ex, t);
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        return Vec{std::vector<double>{std::numeric_limits<double>::quiet_NaN()}};
+    }
+};
+
+// all steps until tend, with a controller owned by the test
+template <typename SolverType>
+Vec run_with(const SolverType &solver, AdaptiveController &controller,
+             Mesh1d &ex, Vec var, double tend) {
+    double t = 0;
+    bool stop_flag = false;
+    while (!stop_flag) {
+        var = solver.update(var, controller, ex, t, stop_flag, tend);
+    }
+    EXPECT_DOUBLE_EQ(t, tend);
+    return var;
+}
+}  // namespace
+
+TEST(AdaptiveTest, ToleranceAndFewerSteps) {
+    auto ex = Mesh1d{0.5};
+    auto u0 = Vec{std::vector<double>{1.0}};
+    auto controller = AdaptiveController{AdaptiveOptions{.atol = 1e-4, .rtol = 1e-4}};
+
+    auto u = run_with(AdaptiveC{}, controller, ex, u0, 1.0);
+
+    EXPECT_NEAR(u[0], 0.5, 1e-4);
+    // far fewer than the 100 steps of a CFL-like dt = 0.01
+    EXPECT_LT(controller.accepted() + controller.rejected(), 30);
+    EXPECT_GT(controller.accepted(), 1);
+}
+
+TEST(AdaptiveTest, RejectsTooLargeSteps) {
+    auto ex = Mesh1d{0.5};
+    auto u0 = Vec{std::vector<double>{1.0}};
+    auto controller = AdaptiveController{AdaptiveOptions{.atol = 1e-10, .rtol = 1e-10}};
+
+    auto u = run_with(AdaptiveC{}, controller, ex, u0, 1.0);
+
+    EXPECT_GT(controller.rejected(), 0);
+    EXPECT_NEAR(u[0], 0.5, 1e-8);
+}
+
+TEST(AdaptiveTest, CflLimit) {
+    auto ex = Mesh1d{0.01};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    auto limited = AdaptiveController{AdaptiveOptions{.atol = 1e-4, .rtol = 1e-4}};
+    run_with(AdaptiveC{}, limited, ex, u0, 1.0);
+    EXPECT_GE(limited.accepted(), 100);
+
+    auto unlimited = AdaptiveController{
+        AdaptiveOptions{.atol = 1e-4, .rtol = 1e-4, .cfl_limit = false}};
+    run_with(AdaptiveC{}, unlimited, ex, u0, 1.0);
+    EXPECT_LT(unlimited.accepted(), 30);
+}
+
+TEST(AdaptiveTest, StepSizeTooSmall) {
+    auto ex = Mesh1d{0.5};
+    auto res = BlowUpC{}.run(Vec{std::vector<double>{1.0}}, ex, 0, 1.0);
+
+    ASSERT_FALSE(res.has_value());
+    EXPECT_EQ(res.error(), "Step size too small");
+}
+
+TEST(AdaptiveTest, FrameworksAgree) {
+    auto ex = Mesh1d{0.5};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    auto ref = AdaptiveC{}.run(u0, ex, 0, 1.0).value();
+
+    using N = solver_template::OpNull<Vec, Mesh1d>;
+    auto op_L = [](const Vec &var, Mesh1d &mesh, double t) {
+        return quadratic_L(var, mesh, t);
+    };
+    auto get_dt = [](const Vec &var, Mesh1d &mesh, double t) {
+        return ode_dt(var, mesh, t);
+    };
+    using U = solver_template::AdaptiveRK3Updater<Vec, Mesh1d, decltype(op_L),
+                                                  decltype(get_dt), N, N, N>;
+    auto solver_t = solver_template::AdaptiveSolver<Vec, Mesh1d, U>{
+        U{op_L, get_dt, {}, {}, {}}, {}};
+
+    using F = solver_stdfunc::AdaptiveUpdaterFactory<Vec, Mesh1d>;
+    auto solver_f = solver_stdfunc::AdaptiveSolver<Vec, Mesh1d>{};
+    solver_f.set_update(F::get_rk3_updater(quadratic_L, ode_dt, {}, {}, {}));
+
+    auto results = {
+        AdaptiveV{}.run(u0, ex, 0, 1.0).value(),
+        solver_t.run(u0, ex, 0, 1.0).value(),
+        solver_f.run(u0, ex, 0, 1.0).value(),
+    };
+
+    for (const auto &res : results) { EXPECT_EQ(res[0], ref[0]); }
+}
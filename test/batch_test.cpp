@@ -0,0 +1,120 @@
+#include "batch.hpp"
+#include "period_index.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace flux;  // NOLINT
+
+namespace {
+double fhat_godunov(double ul, double ur) {
+    if (ul <= ur) {
+        if (ul * ur > 0) { return std::min(ul * ul / 2, ur * ur / 2); }
+        return 0.0;
+    }
+    return std::max(ul * ul / 2, ur * ur / 2);
+}
+
+double df(double u) { return u; }
+
+// Burgers' equation, one problem
+class Godunov : public solver_crtp::RK3Solver<Vec, Mesh1d, Godunov> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        double df_max = 0;
+        for (const auto ui : var.data) {
+            df_max = std::max(df_max, std::abs(df(ui)));
+        }
+        return 0.5 * ex.dx / df_max;
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        const auto &u = var.data;
+        size_t n = u.size();
+        auto L = std::vector<double>(n);
+        for (size_t i = 0; i < n; i++) {
+            auto idx = PeriodIndex(n, i);
+            L[i] = (fhat_godunov(u[idx.l()], u[idx.c()])
+                    - fhat_godunov(u[idx.c()], u[idx.r()]))
+                   / ex.dx;
+        }
+        return Vec{L};
+    }
+};
+
+// Burgers' equation, a batch of problems
+class BatchGodunov
+    : public solver_crtp::RK3Solver<Vec, BatchMesh, BatchGodunov> {
+public:
+    static double get_dt(const Vec &var, BatchMesh &ex, double t) {
+        return batch_step_dt(batch_cfl_dt(var, ex, 0.5, df), ex, t);
+    }
+
+    static Vec op_L(const Vec &var, BatchMesh &ex, double t) {
+        return batch_flux_difference(var, ex, fhat_godunov);
+    }
+};
+
+std::vector<double> init_data(size_t n, double a, double phi) {
+    auto u = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+        double x = 2 * 3.14159265358979323846 * static_cast<double>(i)
+                   / static_cast<double>(n);
+        u[i] = a + std::sin(x + phi);
+    }
+    return u;
+}
+}  // namespace
+
+TEST(BatchTest, PackUnpack) {
+    auto problems = std::vector<std::vector<double>>{{1, 2, 3}, {4, 5, 6}};
+    auto var = batch_pack(problems);
+    EXPECT_EQ(var.data, (std::vector<double>{1, 4, 2, 5, 3, 6}));
+    EXPECT_EQ(batch_unpack(var, 2), problems);
+}
+
+TEST(BatchTest, SharedDt) {
+    size_t n = 64;
+    auto u0 = init_data(n, 0.5, 0.3);
+
+    auto ex = Mesh1d{0.1};
+    auto ref = Godunov{}.run(Vec{u0}, ex, 0, 0.5).value().data;
+
+    // copies of one problem take the same steps as the problem alone
+    auto problems = std::vector<std::vector<double>>(5, u0);
+    auto ex_b = BatchMesh{.dx = 0.1, .batch = 5};
+    auto var = BatchGodunov{}.run(batch_pack(problems), ex_b, 0, 0.5).value();
+    for (const auto &u : batch_unpack(var, 5)) { EXPECT_EQ(u, ref); }
+}
+
+TEST(BatchTest, MaskedDt) {
+    size_t n = 64;
+    auto amplitudes = std::vector<double>{0.2, 0.5, 1.0, 2.0};
+    size_t nb = amplitudes.size();
+
+    auto problems = std::vector<std::vector<double>>{};
+    for (size_t b = 0; b < nb; b++) {
+        double phi = 0.1 * static_cast<double>(b);
+        problems.push_back(init_data(n, amplitudes[b], phi));
+    }
+
+    auto ex_b = BatchMesh{
+        .dx = 0.1, .batch = nb, .dt_mode = BatchDt::Masked, .tend = 0.5};
+    auto var = BatchGodunov{}.run(batch_pack(problems), ex_b, 0, 0.5).value();
+    auto result = batch_unpack(var, nb);
+
+    // every problem took its own steps up to tend
+    for (size_t b = 0; b < nb; b++) {
+        EXPECT_EQ(ex_b.t[b], 0.5);
+
+        auto ex = Mesh1d{0.1};
+        auto ref = Godunov{}.run(Vec{problems[b]}, ex, 0, 0.5).value().data;
+        for (size_t i = 0; i < n; i++) {
+            EXPECT_NEAR(result[b][i], ref[i], 1e-12);
+        }
+    }
+}
@@ -0,0 +1,141 @@
+#include "solver/checkpoint.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_virtual.hpp"
+
+#include "gtest/gtest.h"
+#include "test_problems.hpp"
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using namespace flux;                 // NOLINT
+using namespace flux::test_problems;  // NOLINT
+
+namespace {
+class RK3C : public solver_crtp::RK3Solver<Vec, Mesh1d, RK3C> {
+public:
+    Checkpointer *checkpointer = nullptr;
+
+    Checkpointer *observer() const { return checkpointer; }
+
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return upwind_dt(var, ex, t);
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        return upwind_L(var, ex, t);
+    }
+};
+
+class RK3V : public solver_virtual::RK3Solver<Vec, Mesh1d> {
+public:
+    ObserverBase *checkpointer = nullptr;
+
+    ObserverBase *observer() const override { return checkpointer; }
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const override {
+        return upwind_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const override {
+        return upwind_L(var, ex, t);
+    }
+};
+
+std::string temp_file(const std::string &name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+}
+}  // namespace
+
+TEST(CheckpointTest, RoundTrip) {
+    auto path = temp_file("flux_checkpoint_roundtrip.bin");
+    std::vector<double> params = {0.1, 0.7};
+    std::vector<double> data = {1.0, -2.5, 1e-300, 3.0};
+
+    auto bytes = write_checkpoint(path, 0.375, 42, params, data);
+    ASSERT_TRUE(bytes.has_value());
+    EXPECT_EQ(bytes.value(), 48 + 6 * sizeof(double));
+
+    auto cp = read_checkpoint(path);
+    ASSERT_TRUE(cp.has_value());
+    EXPECT_EQ(cp.value().t, 0.375);
+    EXPECT_EQ(cp.value().step, 42);
+    EXPECT_EQ(cp.value().params, params);
+    EXPECT_EQ(cp.value().data, data);
+
+    std::filesystem::remove(path);
+}
+
+TEST(CheckpointTest, InvalidFile) {
+    auto path = temp_file("flux_checkpoint_invalid.bin");
+    EXPECT_FALSE(read_checkpoint(path + ".missing").has_value());
+
+    std::vector<double> data = {1.0, 2.0};
+    ASSERT_TRUE(write_checkpoint(path, 0, 1, {}, data).has_value());
+    {
+        // flip one byte of the data
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(40);
+        f.put('x');
+    }
+    auto cp = read_checkpoint(path);
+    ASSERT_FALSE(cp.has_value());
+    EXPECT_EQ(cp.error(), "invalid checkpoint file " + path);
+
+    std::filesystem::resize_file(path, 20);
+    EXPECT_FALSE(read_checkpoint(path).has_value());
+
+    std::filesystem::remove(path);
+}
+
+TEST(CheckpointTest, RestartIsBitwise) {
+    auto path = temp_file("flux_checkpoint_restart.bin");
+    auto ex = Mesh1d{0.014};
+    auto u0 = sin_vec(100);
+
+    auto ref = RK3C{}.run(u0, ex, 0, 1.0).value();
+
+    auto solver = RK3C{};
+    {
+        Checkpointer checkpointer{path, 40, {ex.dx}};
+        solver.checkpointer = &checkpointer;
+        auto res = solver.run(u0, ex, 0, 1.0).value();
+        ASSERT_TRUE(checkpointer.wait());
+        EXPECT_EQ(checkpointer.written(), 3);
+        EXPECT_EQ(checkpointer.step(), 143);
+        EXPECT_EQ(res.data, ref.data);
+    }
+
+    auto cp = read_checkpoint(path).value();
+    EXPECT_EQ(cp.step, 120);
+    EXPECT_EQ(cp.params, std::vector<double>{ex.dx});
+
+    // resume with a new checkpointer, which continues the step index
+    Checkpointer checkpointer{path, 40, cp.params, cp.step};
+    solver.checkpointer = &checkpointer;
+    auto res = solver.run(Vec{cp.data}, ex, cp.t, 1.0).value();
+    EXPECT_EQ(checkpointer.step(), 143);
+    EXPECT_EQ(res.data, ref.data);
+
+    // the same through the virtual framework
+    RK3V solver_v;
+    auto res_v = solver_v.run(Vec{cp.data}, ex, cp.t, 1.0).value();
+    EXPECT_EQ(res_v.data, ref.data);
+
+    checkpointer.wait();
+    std::filesystem::remove(path);
+}
+
+TEST(CheckpointTest, WriteError) {
+    auto path = temp_file("flux_checkpoint_missing_dir/restart.bin");
+    Checkpointer checkpointer{path, 1};
+    std::vector<double> data = {1.0};
+    checkpointer.post_step(data, 0.1, 0.1);
+
+    EXPECT_FALSE(checkpointer.wait());
+    EXPECT_FALSE(checkpointer.error().empty());
+    EXPECT_EQ(checkpointer.written(), 0);
+}
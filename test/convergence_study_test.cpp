@@ -0,0 +1,81 @@
+#include "convergence_study.hpp"
+#include "parallel/thread_pool.hpp"
+
+#include <atomic>
+#include <cmath>
+#include <sstream>
+#include <stdexcept>
+
+#include "gtest/gtest.h"
+
+using namespace flux;  // NOLINT
+
+namespace {
+// errors of a scheme of the given order, without running a solver
+ConvergenceStudy::Case fake_scheme(double p, std::atomic<int> &calls) {
+    return [p, &calls](size_t n) {
+        calls++;
+        double e = std::pow(static_cast<double>(n), -p);
+        return ErrorNorms{.l1 = e, .l2 = 2 * e, .linf = 4 * e};
+    };
+}
+}  // namespace
+
+TEST(ConvergenceStudyTest, ErrorsAndOrders) {
+    ThreadPool pool{4};
+    std::atomic<int> calls{0};
+
+    auto study = ConvergenceStudy{{10, 20, 40, 80}, &pool};
+    study.add("first", fake_scheme(1, calls));
+    study.add("third", fake_scheme(3, calls));
+    auto tables = study.run();
+
+    EXPECT_EQ(calls, 8);
+    ASSERT_EQ(tables.size(), 2);
+    EXPECT_EQ(tables[0].name, "first");
+    EXPECT_EQ(tables[1].name, "third");
+
+    for (size_t i = 0; i < 4; i++) {
+        double n = static_cast<double>(tables[1].nlist[i]);
+        EXPECT_DOUBLE_EQ(tables[1].error_l1[i], std::pow(n, -3));
+        EXPECT_DOUBLE_EQ(tables[1].error_l2[i], 2 * std::pow(n, -3));
+        EXPECT_DOUBLE_EQ(tables[1].error_linf[i], 4 * std::pow(n, -3));
+    }
+    for (size_t i = 1; i < 4; i++) {
+        EXPECT_NEAR(tables[0].order_l1[i], 1, 1e-12);
+        EXPECT_NEAR(tables[1].order_l2[i], 3, 1e-12);
+        EXPECT_NEAR(tables[1].order_linf[i], 3, 1e-12);
+    }
+}
+
+TEST(ConvergenceStudyTest, SameTableAsSerial) {
+    std::vector<size_t> nlist = {10, 20, 40};
+    std::vector<double> e1 = {0.1, 0.05, 0.025};
+    std::vector<double> e2 = {0.2, 0.1, 0.05};
+    std::vector<double> einf = {0.4, 0.2, 0.1};
+
+    std::ostringstream ref;
+    print_error_table(ref, nlist, e1, e2, einf, order(e1, nlist),
+                      order(e2, nlist), order(einf, nlist), ' ');
+
+    ThreadPool pool{3};
+    auto study = ConvergenceStudy{nlist, &pool};
+    study.add("scheme", [&](size_t n) {
+        size_t i = n == 10 ? 0 : (n == 20 ? 1 : 2);
+        return ErrorNorms{.l1 = e1[i], .l2 = e2[i], .linf = einf[i]};
+    });
+
+    std::ostringstream out;
+    study.run().front().print(out, ' ');
+    EXPECT_EQ(out.str(), ref.str());
+}
+
+TEST(ConvergenceStudyTest, Exception) {
+    ThreadPool pool{2};
+    auto study = ConvergenceStudy{{10, 20, 40}, &pool};
+    study.add("failing", [](size_t n) {
+        if (n == 20) { throw std::runtime_error{"diverged"}; }
+        return ErrorNorms{};
+    });
+    EXPECT_THROW(study.run(), std::runtime_error);
+}
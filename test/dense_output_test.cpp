@@ -0,0 +1,121 @@
+#include "solver/dense_output.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_stdfunc.hpp"
+#include "solver/solver_template.hpp"
+#include "solver/solver_virtual.hpp"
+
+#include "gtest/gtest.h"
+#include "test_problems.hpp"
+
+#include <cmath>
+#include <vector>
+
+using namespace flux;                 // NOLINT
+using namespace flux::test_problems;  // NOLINT
+
+namespace {
+using RK3C = RK3Crtp<ode_dt, quadratic_L>;
+using RK3V = RK3Virtual<ode_dt, quadratic_L>;
+
+struct Snapshot {
+    double t;
+    double u;
+};
+}  // namespace
+
+TEST(DenseOutputTest, StepsUnchanged) {
+    auto ex = Mesh1d{0.03};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    std::vector<double> times;
+    for (int i = 0; i <= 100; i++) { times.push_back(0.01 * i); }
+    std::vector<Snapshot> snapshots;
+    DenseOutput<Vec> dense{times, [&](double t, const Vec &u) {
+                               snapshots.push_back({t, u[0]});
+                           }};
+
+    auto ref = RK3C{}.run(u0, ex, 0, 1.0).value();
+    auto res = RK3C{}.run_dense(u0, ex, 0, 1.0, dense).value();
+
+    // the output times do not truncate any step
+    EXPECT_EQ(res[0], ref[0]);
+    ASSERT_EQ(snapshots.size(), times.size());
+    EXPECT_EQ(dense.count(), times.size());
+    EXPECT_EQ(snapshots.front().u, 1.0);
+    EXPECT_EQ(snapshots.back().u, ref[0]);
+
+    for (size_t i = 0; i < snapshots.size(); i++) {
+        EXPECT_EQ(snapshots[i].t, times[i]);
+        EXPECT_NEAR(snapshots[i].u, 1.0 / (1.0 + times[i]), 1e-5);
+    }
+}
+
+TEST(DenseOutputTest, TimesOutsideAndUnsorted) {
+    auto ex = Mesh1d{0.1};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    std::vector<double> seen;
+    DenseOutput<Vec> dense{{0.75, -1.0, 0.25, 2.0, 0.5},
+                           [&](double t, const Vec &u) { seen.push_back(t); }};
+    RK3C{}.run_dense(u0, ex, 0, 1.0, dense).value();
+
+    EXPECT_EQ(seen, (std::vector<double>{0.25, 0.5, 0.75}));
+}
+
+TEST(DenseOutputTest, StartTime) {
+    auto ex = Mesh1d{0.01};
+    auto u0 = Vec{std::vector<double>{0.5}};
+
+    auto res = RK3C{}.run(u0, ex, 1.0, 2.0).value();
+    EXPECT_NEAR(res[0], 1.0 / 3, 1e-8);
+}
+
+TEST(DenseOutputTest, FrameworksAgree) {
+    auto ex = Mesh1d{0.03};
+    auto u0 = Vec{std::vector<double>{1.0}};
+    std::vector<double> times = {0.1, 0.2, 0.35, 0.9};
+
+    auto collect = [&](auto &&run) {
+        std::vector<double> values;
+        DenseOutput<Vec> dense{
+            times, [&](double t, const Vec &u) { values.push_back(u[0]); }};
+        run(dense);
+        return values;
+    };
+
+    auto ref = collect([&](DenseOutput<Vec> &dense) {
+        RK3C{}.run_dense(u0, ex, 0, 1.0, dense).value();
+    });
+
+    using N = solver_template::OpNull<Vec, Mesh1d>;
+    auto op_L = [](const Vec &var, Mesh1d &mesh, double t) {
+        return quadratic_L(var, mesh, t);
+    };
+    auto get_dt = [](const Vec &var, Mesh1d &mesh, double t) {
+        return ode_dt(var, mesh, t);
+    };
+    using U = solver_template::RK3Updater<Vec, Mesh1d, decltype(op_L),
+                                          decltype(get_dt), N, N, N>;
+    auto solver_t =
+        solver_template::Solver<Vec, Mesh1d, U>{U{op_L, get_dt, {}, {}, {}}};
+
+    using F = solver_stdfunc::UpdaterFactory<Vec, Mesh1d>;
+    auto solver_f = solver_stdfunc::Solver<Vec, Mesh1d>{};
+    solver_f.set_dense_update(
+        F::get_rk3_dense_updater(quadratic_L, ode_dt, {}, {}, {}));
+
+    auto results = {
+        collect([&](DenseOutput<Vec> &dense) {
+            RK3V{}.run_dense(u0, ex, 0, 1.0, dense).value();
+        }),
+        collect([&](DenseOutput<Vec> &dense) {
+            solver_t.run_dense(u0, ex, 0, 1.0, dense).value();
+        }),
+        collect([&](DenseOutput<Vec> &dense) {
+            solver_f.run_dense(u0, ex, 0, 1.0, dense).value();
+        }),
+    };
+
+    for (const auto &res : results) { EXPECT_EQ(res, ref); }
+}
@@ -0,0 +1,60 @@
+#include "parallel/domain.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <mpi.h>
+#include <vector>
+
+using namespace flux;  // NOLINT
+
+// run with mpiexec -n <ranks>, every rank checks its own subdomains
+
+namespace {
+std::vector<double> init_data(size_t n) {
+    auto u = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+        u[i] = std::sin(0.1 * static_cast<double>(i));
+    }
+    return u;
+}
+}  // namespace
+
+TEST(DomainMpiTest, ScatterExchangeGather) {
+    size_t n = 37;
+    auto global = init_data(n);
+
+    for (size_t parts_per_rank : std::vector<size_t>{1, 2}) {
+        auto domain = Decomposition{n, parts_per_rank, 3, MPI_COMM_WORLD};
+        ASSERT_EQ(domain.parts(), parts_per_rank);
+
+        auto state = domain.scatter(global);
+        EXPECT_EQ(domain.gather(state), global);
+
+        // the ghosts are the periodic neighbours, also across ranks
+        for (size_t k = 0; k < domain.parts(); k++) {
+            const auto &p = domain.part(k);
+            auto u = domain.local(state, p);
+            for (size_t i = 0; i < p.cells + 6; i++) {
+                EXPECT_EQ(u[i], global[(p.begin + n + i - 3) % n]);
+            }
+        }
+    }
+}
+
+TEST(DomainMpiTest, Reductions) {
+    auto domain = Decomposition{64, 2, 1, MPI_COMM_WORLD};
+    auto first = [](const Part &p) { return static_cast<double>(p.begin); };
+    auto last_part = 2 * domain.ranks() - 1;
+    EXPECT_EQ(domain.min_over_parts(first), 0);
+    EXPECT_EQ(domain.max_over_parts(first),
+              static_cast<double>(last_part * 64 / (2 * domain.ranks())));
+}
+
+int main(int argc, char **argv) {
+    MPI_Init(&argc, &argv);
+    ::testing::InitGoogleTest(&argc, argv);
+    int result = RUN_ALL_TESTS();
+    MPI_Finalize();
+    return result;
+}
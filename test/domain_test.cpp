@@ -0,0 +1,155 @@
+#include "parallel/domain.hpp"
+#include "parallel/thread_pool.hpp"
+#include "period_index.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+using namespace flux;  // NOLINT
+
+namespace {
+double fhat_godunov(double ul, double ur) {
+    if (ul <= ur) {
+        if (ul * ur > 0) { return std::min(ul * ul / 2, ur * ur / 2); }
+        return 0.0;
+    }
+    return std::max(ul * ul / 2, ur * ur / 2);
+}
+
+// Burgers' equation on the global grid
+class Godunov : public solver_crtp::RK3InplaceSolver<Vec, Mesh1d, Godunov> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        double df_max = 0;
+        for (const auto ui : var.data) {
+            df_max = std::max(df_max, std::abs(ui));
+        }
+        return 0.5 * ex.dx / df_max;
+    }
+
+    static void op_L(const Vec &var, Vec &out, Mesh1d &ex, double t) {
+        const auto &u = var.data;
+        size_t n = u.size();
+        for (size_t i = 0; i < n; i++) {
+            auto idx = PeriodIndex(n, i);
+            out[i] = (fhat_godunov(u[idx.l()], u[idx.c()])
+                      - fhat_godunov(u[idx.c()], u[idx.r()]))
+                     / ex.dx;
+        }
+    }
+};
+
+// the same on subdomains, the ghosts are exchanged before every stage
+class DomainGodunov
+    : public solver_crtp::RK3InplaceSolver<Vec, Mesh1d, DomainGodunov> {
+public:
+    explicit DomainGodunov(const Decomposition &domain) : m_domain(domain) {}
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const {
+        double df_max = m_domain.max_over_parts([&](const Part &p) {
+            auto u = m_domain.local(var.data, p);
+            double result = 0;
+            for (size_t i = 1; i <= p.cells; i++) {
+                result = std::max(result, std::abs(u[i]));
+            }
+            return result;
+        });
+        return 0.5 * ex.dx / df_max;
+    }
+
+    void op_L(const Vec &var, Vec &out, Mesh1d &ex, double t) const {
+        m_domain.for_each_part([&](const Part &p) {
+            auto u = m_domain.local(var.data, p);
+            auto L = m_domain.local(out.data, p);
+            for (size_t i = 1; i <= p.cells; i++) {
+                L[i] = (fhat_godunov(u[i - 1], u[i])
+                        - fhat_godunov(u[i], u[i + 1]))
+                       / ex.dx;
+            }
+        });
+    }
+
+    void pre_process(Vec &var, Mesh1d &ex, double t) const {
+        m_domain.exchange(var.data);
+    }
+
+    void post_process_rk_stage(Vec &var, Mesh1d &ex, double t) const {
+        m_domain.exchange(var.data);
+    }
+
+private:
+    const Decomposition &m_domain;
+};
+
+std::vector<double> init_data(size_t n) {
+    auto u = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+        u[i] = 0.5 + std::sin(0.1 * static_cast<double>(i));
+    }
+    return u;
+}
+}  // namespace
+
+TEST(DomainTest, Layout) {
+    auto domain = Decomposition{10, 3, 2};
+    ASSERT_EQ(domain.parts(), 3);
+    EXPECT_EQ(domain.part(0).begin, 0);
+    EXPECT_EQ(domain.part(1).begin, 3);
+    EXPECT_EQ(domain.part(2).begin, 6);
+    EXPECT_EQ(domain.part(2).cells, 4);
+
+    // every block starts on a cache line
+    for (size_t k = 0; k < 3; k++) { EXPECT_EQ(domain.part(k).offset % 8, 0); }
+
+    EXPECT_THROW((Decomposition{5, 3, 2}), std::invalid_argument);
+    EXPECT_THROW((Decomposition{5, 0, 1}), std::invalid_argument);
+}
+
+TEST(DomainTest, ScatterExchangeGather) {
+    size_t n = 23;
+    auto global = init_data(n);
+
+    for (size_t halo : std::vector<size_t>{0, 1, 3}) {
+        auto domain = Decomposition{n, 4, halo};
+        auto state = domain.scatter(global);
+        EXPECT_EQ(domain.gather(state), global);
+
+        // the ghosts are the periodic neighbours
+        for (size_t k = 0; k < domain.parts(); k++) {
+            const auto &p = domain.part(k);
+            auto u = domain.local(state, p);
+            for (size_t i = 0; i < p.cells + 2 * halo; i++) {
+                size_t j = (p.begin + n + i - halo) % n;
+                EXPECT_EQ(u[i], global[j]);
+            }
+        }
+    }
+}
+
+TEST(DomainTest, Reductions) {
+    auto domain = Decomposition{100, 4, 1};
+    auto first = [](const Part &p) { return static_cast<double>(p.begin); };
+    EXPECT_EQ(domain.min_over_parts(first), 0);
+    EXPECT_EQ(domain.max_over_parts(first), 75);
+}
+
+TEST(DomainTest, SameAsGlobalOperator) {
+    size_t n = 200;
+    auto u0 = init_data(n);
+
+    auto ex = Mesh1d{0.05};
+    auto ref = Godunov{}.run(Vec{u0}, ex, 0, 1.0).value().data;
+
+    ThreadPool pool{3};
+    for (size_t parts : std::vector<size_t>{1, 3, 8}) {
+        auto domain = Decomposition{n, parts, 1, &pool};
+        auto var = Vec{domain.scatter(u0)};
+        var = DomainGodunov{domain}.run(var, ex, 0, 1.0).value();
+        EXPECT_EQ(domain.gather(var.data), ref);
+    }
+}
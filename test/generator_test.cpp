@@ -0,0 +1,136 @@
+#include "solver/generator.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_stdfunc.hpp"
+#include "solver/solver_template.hpp"
+#include "solver/solver_virtual.hpp"
+
+#include "gtest/gtest.h"
+#include "test_problems.hpp"
+
+#include <stdexcept>
+#include <vector>
+
+using namespace flux;                 // NOLINT
+using namespace flux::test_problems;  // NOLINT
+
+namespace {
+using RK3C = RK3Crtp<ode_dt, decay_L>;
+using RK3InplaceC = RK3InplaceCrtp<ode_dt, decay_L_inplace>;
+using RK3V = RK3Virtual<ode_dt, decay_L>;
+
+class ThrowC : public solver_crtp::EulerSolver<Vec, Mesh1d, ThrowC> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return ode_dt(var, ex, t);
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        if (t > 0.25) { throw std::runtime_error{"op_L failed"}; }
+        return decay_L(var, ex, t);
+    }
+};
+
+template <typename SolverType>
+std::vector<double> stream_values(const SolverType &solver, const Vec &u0,
+                                  Mesh1d &ex) {
+    std::vector<double> values;
+    for (const auto &[t, dt, var] : solver.stream(u0, ex, 0, 1.0)) {
+        values.push_back(var[0]);
+    }
+    return values;
+}
+}  // namespace
+
+TEST(GeneratorTest, StreamMatchesRun) {
+    auto ex = Mesh1d{0.3};
+    auto u0 = Vec{std::vector<double>{1.0, 2.0}};
+    auto solver = RK3C{};
+
+    auto ref = solver.run(u0, ex, 0, 1.0).value();
+
+    std::vector<double> ts;
+    double dt_sum = 0;
+    Vec last = u0;
+    for (const auto &step : solver.stream(u0, ex, 0, 1.0)) {
+        ts.push_back(step.t);
+        dt_sum += step.dt;
+        last = step.var;
+    }
+
+    EXPECT_EQ(ts.size(), 4);
+    EXPECT_DOUBLE_EQ(ts.back(), 1.0);
+    EXPECT_DOUBLE_EQ(ts[0], 0.3);
+    EXPECT_DOUBLE_EQ(dt_sum, 1.0);
+    EXPECT_EQ(last.data, ref.data);
+}
+
+TEST(GeneratorTest, InplaceStreamIsZeroCopy) {
+    auto ex = Mesh1d{0.125};
+    auto u0 = Vec{std::vector<double>{1.0}};
+    auto solver = RK3InplaceC{};
+
+    const Vec *address = nullptr;
+    std::size_t steps = 0;
+    for (const auto &step : solver.stream(u0, ex, 0, 1.0)) {
+        if (address == nullptr) { address = &step.var; }
+        EXPECT_EQ(&step.var, address);
+        steps++;
+    }
+    EXPECT_EQ(steps, 8);
+}
+
+TEST(GeneratorTest, StopEarly) {
+    auto ex = Mesh1d{0.01};
+    auto u0 = Vec{std::vector<double>{1.0}};
+    auto solver = RK3C{};
+
+    std::size_t steps = 0;
+    for ([[maybe_unused]] const auto &step : solver.stream(u0, ex, 0, 1.0)) {
+        if (++steps == 3) break;
+    }
+    EXPECT_EQ(steps, 3);
+
+    auto gen = solver.stream(u0, ex, 0, 0);
+    EXPECT_TRUE(gen.begin() == gen.end());
+}
+
+TEST(GeneratorTest, ExceptionPropagates) {
+    auto ex = Mesh1d{0.1};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    auto solver = ThrowC{};
+
+    auto consume = [&]() {
+        for ([[maybe_unused]] const auto &step :
+             solver.stream(u0, ex, 0, 1.0)) {}
+    };
+    EXPECT_THROW(consume(), std::runtime_error);
+}
+
+TEST(GeneratorTest, FrameworksAgree) {
+    auto ex = Mesh1d{0.1};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    auto ref = stream_values(RK3C{}, u0, ex);
+
+    using N = solver_template::OpNull<Vec, Mesh1d>;
+    auto op_L = [](const Vec &var, Mesh1d &mesh, double t) {
+        return decay_L(var, mesh, t);
+    };
+    auto get_dt = [](const Vec &var, Mesh1d &mesh, double t) {
+        return ode_dt(var, mesh, t);
+    };
+    using U = solver_template::RK3Updater<Vec, Mesh1d, decltype(op_L),
+                                          decltype(get_dt), N, N, N>;
+    auto solver_t =
+        solver_template::Solver<Vec, Mesh1d, U>{U{op_L, get_dt, {}, {}, {}}};
+
+    using F = solver_stdfunc::UpdaterFactory<Vec, Mesh1d>;
+    auto solver_f = solver_stdfunc::Solver<Vec, Mesh1d>{};
+    solver_f.set_update(F::get_rk3_updater(decay_L, ode_dt, {}, {}, {}));
+
+    EXPECT_EQ(stream_values(RK3V{}, u0, ex), ref);
+    EXPECT_EQ(stream_values(solver_t, u0, ex), ref);
+    EXPECT_EQ(stream_values(solver_f, u0, ex), ref);
+}
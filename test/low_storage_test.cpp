@@ -0,0 +1,126 @@
+#include "solver/low_storage.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_stdfunc.hpp"
+#include "solver/solver_template.hpp"
+#include "solver/solver_virtual.hpp"
+
+#include "gtest/gtest.h"
+#include "test_problems.hpp"
+
+#include <cmath>
+
+using namespace flux;                 // NOLINT
+using namespace flux::test_problems;  // NOLINT
+
+namespace {
+// u' = -u^2, the exact solution at t = 1 is 0.5
+template <auto Tableau>
+class LSC : public solver_crtp::LowStorageSolver<Vec, Mesh1d, Tableau,
+                                                 LSC<Tableau>> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return ode_dt(var, ex, t);
+    }
+
+    static void op_L_acc(const Vec &var, Vec &out, double a, Mesh1d &ex,
+                         double t) {
+        quadratic_L_acc(var, out, a, ex, t);
+    }
+};
+
+template <auto Tableau>
+class LSV : public solver_virtual::LowStorageSolver<Vec, Mesh1d, Tableau> {
+public:
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const override {
+        return ode_dt(var, ex, t);
+    }
+
+    void op_L_acc(const Vec &var, Vec &out, double a, Mesh1d &ex,
+                  double t) const override {
+        quadratic_L_acc(var, out, a, ex, t);
+    }
+};
+
+struct GetDtP {
+    double operator()(const Vec &var, Mesh1d &ex, double t) const {
+        return ode_dt(var, ex, t);
+    }
+};
+
+struct OpLAccP {
+    void operator()(const Vec &var, Vec &out, double a, Mesh1d &ex,
+                    double t) const {
+        quadratic_L_acc(var, out, a, ex, t);
+    }
+};
+
+template <auto Tableau>
+double ls_error(double dt) {
+    auto ex = Mesh1d{dt};
+    auto u = LSC<Tableau>{}.run(Vec{std::vector<double>{1.0}}, ex, 0, 1.0);
+    return std::abs(u.value()[0] - 0.5);
+}
+
+template <auto Tableau>
+double ls_order() {
+    return std::log2(ls_error<Tableau>(0.05) / ls_error<Tableau>(0.025));
+}
+}  // namespace
+
+TEST(LowStorageTest, StageTimes) {
+    constexpr auto c3 = low_storage::williamson33.c();
+    EXPECT_DOUBLE_EQ(c3[1], 1.0 / 3);
+    EXPECT_DOUBLE_EQ(c3[2], 3.0 / 4);
+    EXPECT_DOUBLE_EQ(c3[3], 1.0);
+
+    constexpr auto c5 = low_storage::ck54.c();
+    EXPECT_NEAR(c5[1], 1432997174477.0 / 9575080441755, 1e-14);
+    EXPECT_NEAR(c5[2], 2526269341429.0 / 6820363962896, 1e-12);
+    EXPECT_NEAR(c5[3], 2006345519317.0 / 3224310063776, 1e-12);
+    EXPECT_NEAR(c5[4], 2802321613138.0 / 2924317926251, 1e-12);
+    EXPECT_NEAR(c5[5], 1.0, 1e-12);
+}
+
+TEST(LowStorageTest, ConvergenceOrder) {
+    EXPECT_NEAR(ls_order<low_storage::williamson33>(), 3.0, 0.1);
+    EXPECT_NEAR(ls_order<low_storage::ck54>(), 4.0, 0.15);
+}
+
+TEST(LowStorageTest, TwoRegisters) {
+    auto ex = Mesh1d{0.1};
+    auto var = Vec{std::vector<double>{1.0, 2.0, 3.0}};
+    StageBuffers<Vec> buffers;
+    double t = 0;
+    bool stop_flag = false;
+
+    LSC<low_storage::ck54>{}.update(var, buffers, ex, t, stop_flag, 1.0);
+    LSC<low_storage::ck54>{}.update(var, buffers, ex, t, stop_flag, 1.0);
+    EXPECT_EQ(buffers.size(), 1);
+}
+
+TEST(LowStorageTest, FrameworksAgree) {
+    auto ex = Mesh1d{0.05};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    constexpr auto tableau = low_storage::ck54;
+    auto ref = LSC<tableau>{}.run(u0, ex, 0, 1.0).value();
+
+    using N = solver_template::InplaceOpNull<Vec, Mesh1d>;
+    using U = solver_template::LowStorageUpdater<Vec, Mesh1d, tableau, OpLAccP,
+                                                 GetDtP, N, N, N>;
+    using F = solver_stdfunc::InplaceUpdaterFactory<Vec, Mesh1d>;
+
+    auto solver_f = solver_stdfunc::InplaceSolver<Vec, Mesh1d>{};
+    solver_f.set_update(
+        F::get_low_storage_updater<tableau>(quadratic_L_acc, ode_dt, {}, {}, {}));
+
+    auto results = {
+        LSV<tableau>{}.run(u0, ex, 0, 1.0).value(),
+        solver_template::InplaceSolver<Vec, Mesh1d, U>{}.run(u0, ex, 0, 1.0)
+            .value(),
+        solver_f.run(u0, ex, 0, 1.0).value(),
+    };
+
+    for (const auto &res : results) { EXPECT_EQ(res[0], ref[0]); }
+}
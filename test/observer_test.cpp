@@ -0,0 +1,333 @@
+#include "solver/dense_output.hpp"
+#include "solver/observer.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_stdfunc.hpp"
+#include "solver/solver_template.hpp"
+#include "solver/solver_virtual.hpp"
+
+#include "gtest/gtest.h"
+#include "test_problems.hpp"
+
+#include <cstddef>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace flux;                 // NOLINT
+using namespace flux::test_problems;  // NOLINT
+
+namespace {
+struct Event {
+    std::string name;
+    double t;
+    double dt;
+    const double *data;
+
+    bool operator==(const Event &rhs) const = default;
+};
+
+// compile-time observer, writes into an external log
+struct LogObserver {
+    std::vector<Event> *log;
+
+    void pre_step(std::span<const double> var, double t, double dt) const {
+        log->push_back({"pre_step", t, dt, var.data()});
+    }
+
+    void post_stage(std::span<const double> var, double t, double dt) const {
+        log->push_back({"post_stage", t, dt, var.data()});
+    }
+
+    void post_step(std::span<const double> var, double t, double dt) const {
+        log->push_back({"post_step", t, dt, var.data()});
+    }
+};
+
+// runtime observer
+class LogObserverV : public ObserverBase {
+public:
+    std::vector<Event> log;
+
+    void pre_step(std::span<const double> var, double t, double dt) override {
+        log.push_back({"pre_step", t, dt, var.data()});
+    }
+
+    void post_stage(std::span<const double> var, double t,
+                    double dt) override {
+        log.push_back({"post_stage", t, dt, var.data()});
+    }
+
+    void post_step(std::span<const double> var, double t, double dt) override {
+        log.push_back({"post_step", t, dt, var.data()});
+    }
+};
+
+class RK3C : public solver_crtp::RK3Solver<Vec, Mesh1d, RK3C> {
+public:
+    std::vector<Event> *log = nullptr;
+
+    LogObserver observer() const { return {log}; }
+
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return ode_dt(var, ex, t);
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        return decay_L(var, ex, t);
+    }
+};
+
+using RK3NoObserverC = RK3Crtp<ode_dt, decay_L>;
+
+class RK3InplaceC
+    : public solver_crtp::RK3InplaceSolver<Vec, Mesh1d, RK3InplaceC> {
+public:
+    std::vector<Event> *log = nullptr;
+
+    LogObserver observer() const { return {log}; }
+
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return ode_dt(var, ex, t);
+    }
+
+    static void op_L(const Vec &var, Vec &out, Mesh1d &ex, double t) {
+        decay_L_inplace(var, out, ex, t);
+    }
+};
+
+class RK3V : public solver_virtual::RK3Solver<Vec, Mesh1d> {
+public:
+    ObserverBase *obs = nullptr;
+
+    ObserverBase *observer() const override { return obs; }
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const override {
+        return ode_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const override {
+        return decay_L(var, ex, t);
+    }
+};
+
+class RKC
+    : public solver_crtp::RKSolver<Vec, Mesh1d, shu_osher::ssprk33, RKC> {
+public:
+    std::vector<Event> *log = nullptr;
+
+    LogObserver observer() const { return {log}; }
+
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return ode_dt(var, ex, t);
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        return decay_L(var, ex, t);
+    }
+};
+
+class LSV : public solver_virtual::LowStorageSolver<Vec, Mesh1d,
+                                                   low_storage::williamson33> {
+public:
+    ObserverBase *obs = nullptr;
+
+    ObserverBase *observer() const override { return obs; }
+
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const override {
+        return ode_dt(var, ex, t);
+    }
+
+    void op_L_acc(const Vec &var, Vec &out, double a, Mesh1d &ex,
+                  double t) const override {
+        quadratic_L_acc(var, out, a, ex, t);
+    }
+};
+
+// u' = -u^2, ex.dx is a loose bound, so the first attempts are rejected
+class AdaptiveC
+    : public solver_crtp::AdaptiveRK3Solver<Vec, Mesh1d, AdaptiveC> {
+public:
+    std::vector<Event> *log = nullptr;
+
+    LogObserver observer() const { return {log}; }
+
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return ode_dt(var, ex, t);
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        return quadratic_L(var, ex, t);
+    }
+};
+
+std::vector<std::string> names(const std::vector<Event> &log) {
+    std::vector<std::string> result;
+    for (const auto &e : log) { result.push_back(e.name); }
+    return result;
+}
+
+// events without the data pointers, which differ between frameworks
+std::vector<Event> without_data(std::vector<Event> log) {
+    for (auto &e : log) { e.data = nullptr; }
+    return log;
+}
+}  // namespace
+
+TEST(ObserverTest, EventOrder) {
+    auto ex = Mesh1d{0.5};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    std::vector<Event> log;
+    auto solver = RK3C{};
+    solver.log = &log;
+    auto res = solver.run(u0, ex, 0, 1.0).value();
+
+    std::vector<std::string> step = {"pre_step", "post_stage", "post_stage",
+                                     "post_stage", "post_step"};
+    std::vector<std::string> expected = step;
+    expected.insert(expected.end(), step.begin(), step.end());
+    EXPECT_EQ(names(log), expected);
+
+    EXPECT_EQ(log[0].t, 0);
+    EXPECT_EQ(log[0].dt, 0.5);
+    EXPECT_EQ(log[2].t, 0.5);   // second stage at t + dt
+    EXPECT_EQ(log[3].t, 0.25);  // third stage at t + dt / 2
+    EXPECT_EQ(log[4].t, 0.5);
+    EXPECT_EQ(log[9].t, 1.0);
+
+    // observing does not change the result
+    EXPECT_EQ(res.data, RK3NoObserverC{}.run(u0, ex, 0, 1.0).value().data);
+}
+
+TEST(ObserverTest, InplaceViewIsZeroCopy) {
+    auto ex = Mesh1d{0.25};
+    auto u0 = Vec{std::vector<double>{1.0, 2.0}};
+
+    std::vector<Event> log;
+    auto solver = RK3InplaceC{};
+    solver.log = &log;
+    solver.run(u0, ex, 0, 1.0).value();
+
+    ASSERT_EQ(log.size(), 20);
+    for (const auto &e : log) { EXPECT_EQ(e.data, log[0].data); }
+}
+
+TEST(ObserverTest, NullObserver) {
+    static_assert(ObserverTypeRequirements<NullObserver>);
+    static_assert(ObserverTypeRequirements<LogObserver>);
+    static_assert(ObserverTypeRequirements<LogObserverV *>);
+    static_assert(!ObserverTypeRequirements<int>);
+
+    auto var = Vec{std::vector<double>{1.0}};
+    observe_pre_step(NullObserver{}, var, 0, 1);
+    observe_post_step(static_cast<ObserverBase *>(nullptr), var, 0, 1);
+}
+
+TEST(ObserverTest, FrameworksAgree) {
+    auto ex = Mesh1d{0.25};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    std::vector<Event> ref;
+    auto solver_c = RK3C{};
+    solver_c.log = &ref;
+    solver_c.run(u0, ex, 0, 1.0).value();
+    ref = without_data(ref);
+
+    auto obs_v = LogObserverV{};
+    auto solver_v = RK3V{};
+    solver_v.obs = &obs_v;
+    solver_v.run(u0, ex, 0, 1.0).value();
+    EXPECT_EQ(without_data(obs_v.log), ref);
+
+    std::vector<Event> log_t;
+    using N = solver_template::OpNull<Vec, Mesh1d>;
+    auto op_L = [](const Vec &var, Mesh1d &mesh, double t) {
+        return decay_L(var, mesh, t);
+    };
+    auto get_dt = [](const Vec &var, Mesh1d &mesh, double t) {
+        return ode_dt(var, mesh, t);
+    };
+    using U = solver_template::RK3Updater<Vec, Mesh1d, decltype(op_L),
+                                          decltype(get_dt), N, N, N,
+                                          LogObserver>;
+    auto solver_t = solver_template::Solver<Vec, Mesh1d, U>{
+        U{op_L, get_dt, {}, {}, {}, LogObserver{&log_t}}};
+    solver_t.run(u0, ex, 0, 1.0).value();
+    EXPECT_EQ(without_data(log_t), ref);
+
+    auto obs_f = LogObserverV{};
+    using F = solver_stdfunc::UpdaterFactory<Vec, Mesh1d>;
+    auto solver_f = solver_stdfunc::Solver<Vec, Mesh1d>{};
+    solver_f.set_update(
+        F::get_rk3_updater(decay_L, ode_dt, {}, {}, {}, &obs_f));
+    solver_f.run(u0, ex, 0, 1.0).value();
+    EXPECT_EQ(without_data(obs_f.log), ref);
+}
+
+TEST(ObserverTest, EveryUpdaterObserves) {
+    auto ex = Mesh1d{0.25};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    std::vector<Event> ref;
+    auto solver_c = RK3C{};
+    solver_c.log = &ref;
+    solver_c.run(u0, ex, 0, 1.0).value();
+    ref = without_data(ref);
+
+    // the dense steps are the RK3 steps
+    std::vector<Event> log_d;
+    solver_c.log = &log_d;
+    DenseOutput<Vec> dense{{0.3, 0.6}, [](double t, const Vec &u) {}};
+    solver_c.run_dense(u0, ex, 0, 1.0, dense).value();
+    EXPECT_EQ(without_data(log_d), ref);
+
+    // three stages per step as well
+    std::vector<Event> log_rk;
+    auto solver_rk = RKC{};
+    solver_rk.log = &log_rk;
+    solver_rk.run(u0, ex, 0, 1.0).value();
+    EXPECT_EQ(names(log_rk), names(ref));
+    EXPECT_EQ(log_rk.back().t, 1.0);
+
+    auto obs_ls = LogObserverV{};
+    auto solver_ls = LSV{};
+    solver_ls.obs = &obs_ls;
+    solver_ls.run(u0, ex, 0, 1.0).value();
+    EXPECT_EQ(names(obs_ls.log), names(ref));
+
+    auto obs_f = LogObserverV{};
+    using F = solver_stdfunc::UpdaterFactory<Vec, Mesh1d>;
+    auto solver_f = solver_stdfunc::Solver<Vec, Mesh1d>{};
+    solver_f.set_update(F::get_rk_updater<shu_osher::ssprk33>(
+        decay_L, ode_dt, {}, {}, {}, &obs_f));
+    solver_f.run(u0, ex, 0, 1.0).value();
+    EXPECT_EQ(without_data(obs_f.log), without_data(log_rk));
+}
+
+TEST(ObserverTest, AdaptiveReportsAcceptedSteps) {
+    auto ex = Mesh1d{0.5};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    std::vector<Event> log;
+    auto solver = AdaptiveC{};
+    solver.log = &log;
+    solver.run(u0, ex, 0, 2.0).value();
+
+    // no stages, the rejected attempts are not reported
+    ASSERT_EQ(log.size() % 2, 0);
+    double t = 0;
+    for (std::size_t i = 0; i < log.size(); i += 2) {
+        EXPECT_EQ(log[i].name, "pre_step");
+        EXPECT_EQ(log[i].t, t);
+        EXPECT_EQ(log[i + 1].name, "post_step");
+        EXPECT_LE(log[i + 1].dt, log[i].dt);
+        t += log[i + 1].dt;
+        EXPECT_EQ(log[i + 1].t, t);
+    }
+    EXPECT_EQ(t, 2.0);
+
+    // the first attempt is rejected
+    EXPECT_EQ(log[0].dt, 0.5);
+    EXPECT_LT(log[1].dt, 0.5);
+}
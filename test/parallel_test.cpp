@@ -0,0 +1,346 @@
+#include "error_and_order.hpp"
+#include "parallel/parallel_for.hpp"
+#include "parallel/parallel_reduce.hpp"
+#include "parallel/task_graph.hpp"
+#include "parallel/thread_pool.hpp"
+#include "period_index.hpp"
+#include "weno5.hpp"
+
+#include "gtest/gtest.h"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace flux;  // NOLINT
+
+namespace {
+std::vector<double> init_data(size_t n) {
+    auto u = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+        u[i] = std::sin(0.1 * static_cast<double>(i)) + 0.5;
+    }
+    return u;
+}
+
+// Godunov flux difference of Burgers' equation, as in the FV examples
+std::vector<double> op_L(const std::vector<double> &u,
+                         const ParallelOptions &options) {
+    size_t n = u.size();
+    auto L = std::vector<double>(n);
+    auto fhat = [](double ul, double ur) {
+        if (ul <= ur) {
+            if (ul * ur > 0) { return std::min(ul * ul / 2, ur * ur / 2); }
+            return 0.0;
+        }
+        return std::max(ul * ul / 2, ur * ur / 2);
+    };
+    parallel_for(
+        0, n,
+        [&](size_t i) {
+            auto idx = PeriodIndex(n, i);
+            L[i] = fhat(u[idx.l()], u[idx.c()]) - fhat(u[idx.c()], u[idx.r()]);
+        },
+        options);
+    return L;
+}
+}  // namespace
+
+TEST(ParallelTest, EachIndexOnce) {
+    ThreadPool pool{4};
+    EXPECT_EQ(pool.size(), 4);
+
+    for (auto schedule : {Schedule::Static, Schedule::Dynamic}) {
+        for (size_t n : std::vector<size_t>{0, 1, 7, 100, 1000, 4097}) {
+            auto count = std::vector<std::atomic<int>>(n);
+            parallel_for(
+                0, n, [&](size_t i) { count[i]++; },
+                {.schedule = schedule, .chunk = 16, .grain = 1, .pool = &pool});
+            for (size_t i = 0; i < n; i++) { EXPECT_EQ(count[i], 1); }
+        }
+    }
+
+    auto count = std::vector<std::atomic<int>>(20);
+    parallel_for(5, 15, [&](size_t i) { count[i]++; },
+                 {.grain = 1, .pool = &pool});
+    for (size_t i = 0; i < 20; i++) {
+        EXPECT_EQ(count[i], (i >= 5 && i < 15) ? 1 : 0);
+    }
+}
+
+TEST(ParallelTest, Deterministic) {
+    auto u = init_data(10000);
+    auto ref = op_L(u, {.pool = nullptr});
+
+    ThreadPool serial{1};
+    EXPECT_EQ(op_L(u, {.pool = &serial}), ref);
+
+    for (size_t num_threads : std::vector<size_t>{2, 3, 8}) {
+        ThreadPool pool{num_threads};
+        EXPECT_EQ(op_L(u, {.grain = 1, .pool = &pool}), ref);
+        EXPECT_EQ(op_L(u, {.schedule = Schedule::Dynamic, .chunk = 7,
+                           .grain = 1, .pool = &pool}),
+                  ref);
+    }
+}
+
+TEST(ParallelTest, Weno5) {
+    auto u = init_data(2000);
+    auto ul = std::vector<double>{};
+    auto ur = std::vector<double>{};
+    weno5(u, ul, ur);
+
+    // inside a task the nested loop of weno5 runs serially
+    ThreadPool pool{2};
+    auto ul_ref = std::vector<double>{};
+    auto ur_ref = std::vector<double>{};
+    pool.run(2, [&](size_t task) {
+        if (task == 0) { weno5(u, ul_ref, ur_ref); }
+    });
+    EXPECT_EQ(ul, ul_ref);
+    EXPECT_EQ(ur, ur_ref);
+}
+
+TEST(ParallelTest, ExceptionAndNesting) {
+    ThreadPool pool{4};
+
+    auto throwing = [&]() {
+        parallel_for(
+            0, 1000,
+            [](size_t i) {
+                if (i == 500) { throw std::runtime_error{"cell failed"}; }
+            },
+            {.grain = 1, .pool = &pool});
+    };
+    EXPECT_THROW(throwing(), std::runtime_error);
+
+    // nested loops share the pool instead of deadlocking
+    auto count = std::vector<std::atomic<int>>(100 * 100);
+    parallel_for(
+        0, 100,
+        [&](size_t i) {
+            parallel_for(
+                0, 100, [&](size_t j) { count[i * 100 + j]++; },
+                {.grain = 1, .pool = &pool});
+        },
+        {.grain = 1, .pool = &pool});
+    for (const auto &c : count) { EXPECT_EQ(c, 1); }
+}
+
+TEST(ParallelTest, TaskGroup) {
+    ThreadPool pool{4};
+
+    // recursive spawning, the waiting threads run the pending tasks
+    std::function<long(long)> fib = [&](long k) -> long {
+        if (k < 12) { return k < 2 ? k : fib(k - 1) + fib(k - 2); }
+        long a = 0;
+        long b = 0;
+        TaskGroup group{pool};
+        group.spawn([&]() { a = fib(k - 1); });
+        group.spawn([&]() { b = fib(k - 2); });
+        group.wait();
+        return a + b;
+    };
+    EXPECT_EQ(fib(20), 6765);
+
+    TaskGroup group{pool};
+    group.spawn([]() { throw std::runtime_error{"task failed"}; });
+    group.spawn([]() {});
+    EXPECT_THROW(group.wait(), std::runtime_error);
+}
+
+TEST(ParallelTest, RunPinned) {
+    ThreadPool pool{4};
+
+    // task k on worker k, the last one on the calling thread, every call
+    auto threads = [&]() {
+        auto ids = std::vector<std::thread::id>(pool.size());
+        pool.run_pinned(ids.size(), [&](size_t task) {
+            std::this_thread::sleep_for(std::chrono::microseconds(10 * task));
+            ids[task] = std::this_thread::get_id();
+        });
+        return ids;
+    };
+    auto first = threads();
+    for (size_t k = 0; k < first.size(); k++) {
+        for (size_t j = 0; j < k; j++) { EXPECT_NE(first[k], first[j]); }
+    }
+    EXPECT_EQ(first.back(), std::this_thread::get_id());
+    for (int call = 0; call < 20; call++) { EXPECT_EQ(threads(), first); }
+
+    // the static blocks of parallel_for, also with uneven costs
+    auto blocks = [&]() {
+        auto ids = std::vector<std::thread::id>(1000);
+        parallel_for(
+            0, ids.size(),
+            [&](size_t i) {
+                if (i < 250) {
+                    std::this_thread::sleep_for(std::chrono::microseconds(5));
+                }
+                ids[i] = std::this_thread::get_id();
+            },
+            {.grain = 1, .pool = &pool});
+        return ids;
+    };
+    auto ids = blocks();
+    for (int call = 0; call < 20; call++) { EXPECT_EQ(blocks(), ids); }
+}
+
+TEST(ParallelTest, TaskGraph) {
+    ThreadPool pool{4};
+
+    // a chain per row, every task also waits for its neighbours in the row
+    // above, as the stages of neighbouring blocks
+    const size_t rows = 20;
+    const size_t cols = 16;
+    auto done = std::vector<std::atomic<int>>(rows * cols);
+    auto ok = std::atomic<bool>{true};
+    auto neighbours = [&](size_t j) {
+        return std::array<size_t, 3>{(j + cols - 1) % cols, j, (j + 1) % cols};
+    };
+    TaskGraph graph;
+    auto nodes = std::vector<TaskGraph::Node>(rows * cols);
+    for (size_t i = 0; i < rows; i++) {
+        for (size_t j = 0; j < cols; j++) {
+            size_t k = i * cols + j;
+            nodes[k] = graph.add([&, i, j, k]() {
+                if (i > 0) {
+                    for (size_t c : neighbours(j)) {
+                        // done once more than this task
+                        if (done[(i - 1) * cols + c] != done[k] + 1) {
+                            ok = false;
+                        }
+                    }
+                }
+                done[k]++;
+            });
+            if (i == 0) continue;
+            for (size_t c : neighbours(j)) {
+                graph.depend(nodes[k], nodes[(i - 1) * cols + c]);
+            }
+        }
+    }
+    EXPECT_EQ(graph.size(), rows * cols);
+
+    // every task once per run, again on the second run
+    for (int run = 1; run <= 2; run++) {
+        graph.run(pool);
+        EXPECT_TRUE(ok);
+        for (const auto &d : done) { EXPECT_EQ(d, run); }
+    }
+
+    // the tasks after a failed task are skipped
+    TaskGraph failing;
+    auto a = failing.add([]() { throw std::runtime_error{"task failed"}; });
+    auto b = failing.add([&]() { ok = false; });
+    failing.depend(b, a);
+    EXPECT_THROW(failing.run(pool), std::runtime_error);
+    EXPECT_TRUE(ok);
+}
+
+TEST(ParallelTest, UnevenCost) {
+    ThreadPool pool{4};
+
+    // every 10th cell is expensive, as DG cells which are limited
+    auto count = std::vector<std::atomic<int>>(400);
+    parallel_for(
+        0, count.size(),
+        [&](size_t i) {
+            if (i % 10 == 0) {
+                std::this_thread::sleep_for(std::chrono::microseconds(200));
+            }
+            count[i]++;
+        },
+        {.schedule = Schedule::Dynamic, .chunk = 4, .grain = 1, .pool = &pool});
+    for (const auto &c : count) { EXPECT_EQ(c, 1); }
+}
+
+TEST(ParallelTest, Reduce) {
+    ThreadPool pool{3};
+    auto u = init_data(10001);
+
+    double max_ref = 0;
+    long sum_ref = 0;
+    for (size_t i = 0; i < u.size(); i++) {
+        max_ref = std::max(max_ref, std::abs(u[i]));
+        sum_ref += static_cast<long>(i);
+    }
+
+    auto abs_u = [&](size_t i) { return std::abs(u[i]); };
+    auto max = [](double a, double b) { return std::max(a, b); };
+    auto to_long = [](size_t i) { return static_cast<long>(i); };
+    auto plus = [](long a, long b) { return a + b; };
+    for (auto schedule : {Schedule::Static, Schedule::Dynamic}) {
+        ParallelOptions options{
+            .schedule = schedule, .chunk = 100, .grain = 1, .pool = &pool};
+        EXPECT_EQ(parallel_reduce(0, u.size(), 0.0, abs_u, max, options),
+                  max_ref);
+        EXPECT_EQ(parallel_reduce(0, u.size(), 0L, to_long, plus, options),
+                  sum_ref);
+    }
+    EXPECT_EQ(parallel_reduce(3, 3, 1.5, abs_u, max), 1.5);
+
+    // the same sum on any number of threads, with either schedule
+    auto value = [&](size_t i) { return u[i]; };
+    auto fplus = [](double a, double b) { return a + b; };
+    double sum = parallel_reduce(0, u.size(), 0.0, value, fplus,
+                                 {.chunk = 64, .grain = 1, .pool = &pool});
+    for (size_t threads : {1u, 2u, 5u}) {
+        ThreadPool other{threads};
+        for (auto schedule : {Schedule::Static, Schedule::Dynamic}) {
+            ParallelOptions options{.schedule = schedule,
+                                    .chunk = 64,
+                                    .grain = 1,
+                                    .pool = &other};
+            EXPECT_EQ(parallel_reduce(0, u.size(), 0.0, value, fplus, options),
+                      sum);
+        }
+    }
+}
+
+TEST(ParallelTest, Summation) {
+    // the ones are lost next to 1e16 without the compensation
+    size_t n = 30000;
+    auto term = [](size_t i) {
+        std::array<double, 3> terms{1e16, 1.0, -1e16};
+        return terms[i % 3];
+    };
+    double exact = static_cast<double>(n / 3);
+
+    ThreadPool pool{4};
+    ParallelOptions options{.grain = 1, .pool = &pool};
+    double kahan = parallel_sum(0, n, term, Summation::Kahan, options);
+    EXPECT_EQ(kahan, exact);
+    EXPECT_NE(parallel_sum(0, n, term, Summation::Pairwise, options), exact);
+
+    // bitwise the same as the serial sum
+    options.pool = nullptr;
+    options.grain = n + 1;
+    EXPECT_EQ(parallel_sum(0, n, term, Summation::Kahan, options), kahan);
+
+    auto u = init_data(n);
+    auto v = init_data(n);
+    v[17] += 0.25;
+    EXPECT_EQ(error(u, v, 0.5, ErrorType::Linf), 0.25);
+    EXPECT_EQ(error(u, v, 0.5, ErrorType::L1), 0.125);
+    EXPECT_EQ(error(u, u, 0.5, ErrorType::L2), 0);
+}
+
+TEST(ParallelTest, ExitAfterParallelWork) {
+    // the workers of the global pool are running, the forked child of the
+    // death test has none of them and exits without joining them
+    auto ones = [](size_t i) { return 1.0; };
+    EXPECT_EQ(parallel_sum(0, 100000, ones), 100000);
+    EXPECT_EXIT(std::exit(3), ::testing::ExitedWithCode(3), "");
+
+    auto u = init_data(4);
+    auto v = init_data(5);
+    EXPECT_EXIT(error(u, v, 0.5, ErrorType::L1), ::testing::ExitedWithCode(1),
+                "different length");
+}
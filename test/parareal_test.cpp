@@ -0,0 +1,150 @@
+#include "parallel/thread_pool.hpp"
+#include "solver/parareal.hpp"
+#include "solver/preset.hpp"
+#include "solver/solver_template.hpp"
+#include "weno5.hpp"
+
+#include "gtest/gtest.h"
+#include "test_problems.hpp"
+
+#include <cmath>
+#include <numbers>
+#include <string>
+#include <vector>
+
+using namespace flux;                 // NOLINT
+using namespace flux::test_problems;  // NOLINT
+
+namespace {
+constexpr double pi = std::numbers::pi;
+
+struct GetDt {
+    double cfl;
+
+    double operator()(const Vec &var, Mesh1d &ex, double t) const {
+        double df_max = 0;
+        for (size_t i = 0; i < var.size(); i++) {
+            df_max = std::max(df_max, std::abs(var[i]));
+        }
+        return cfl * ex.dx / df_max;
+    }
+};
+
+// first order, the coarse operator
+struct OpGodunov {
+    Vec operator()(const Vec &var, Mesh1d &ex, double t) const {
+        size_t n = var.size();
+        auto L = std::vector<double>(n);
+        for (size_t i = 0; i < n; i++) {
+            size_t l = (i + n - 1) % n;
+            size_t r = (i + 1) % n;
+            L[i] = (fhat(var[l], var[i]) - fhat(var[i], var[r])) / ex.dx;
+        }
+        return Vec{L};
+    }
+
+    static double fhat(double ul, double ur) {
+        if (ul <= ur) {
+            if (ul * ur > 0) { return std::min(ul * ul / 2, ur * ur / 2); }
+            return 0.0;
+        }
+        return std::max(ul * ul / 2, ur * ur / 2);
+    }
+};
+
+// WENO5 with the Lax-Friedrichs flux, the fine operator
+struct OpWeno {
+    Vec operator()(const Vec &var, Mesh1d &ex, double t) const {
+        size_t n = var.size();
+        auto ul = std::vector<double>(n);
+        auto ur = std::vector<double>(n);
+        weno5(var.data, ul, ur);
+        auto L = std::vector<double>(n);
+        for (size_t i = 0; i < n; i++) {
+            size_t l = (i + n - 1) % n;
+            size_t r = (i + 1) % n;
+            L[i] = (fhat(ur[l], ul[i]) - fhat(ur[i], ul[r])) / ex.dx;
+        }
+        return Vec{L};
+    }
+
+    static double fhat(double ul, double ur) {
+        double c = std::max(std::abs(ul), std::abs(ur));
+        return 0.5 * (ul * ul / 2 + ur * ur / 2) - 0.5 * c * (ur - ul);
+    }
+};
+
+using N = solver_template::OpNull<Vec, Mesh1d>;
+using Coarse = solver_template::Solver<
+    Vec, Mesh1d,
+    solver_template::EulerUpdater<Vec, Mesh1d, OpGodunov, GetDt, N, N>>;
+using Fine = solver_template::Solver<
+    Vec, Mesh1d,
+    solver_template::RK3Updater<Vec, Mesh1d, OpWeno, GetDt, N, N, N>>;
+using Parareal = solver_template::PararealSolver<Vec, Mesh1d, Coarse, Fine>;
+
+// a coarse time step of four fine ones
+const Coarse coarse{{OpGodunov{}, GetDt{0.8}, N{}, N{}}};
+const Fine fine{{OpWeno{}, GetDt{0.2}, N{}, N{}, N{}}};
+
+// the fine solver, stopping at every slice end as Parareal does
+Vec fine_slices(Vec u, Mesh1d &ex, double tend, size_t slices) {
+    for (size_t j = 0; j < slices; j++) {
+        double t0 = tend * static_cast<double>(j) / static_cast<double>(slices);
+        double t1 = j + 1 == slices ? tend
+                                    : tend * static_cast<double>(j + 1)
+                                          / static_cast<double>(slices);
+        u = fine.run(u, ex, t0, t1).value();
+    }
+    return u;
+}
+
+struct Failing {
+    auto run(const Vec &var, Mesh1d &ex, double t0, double tend) const
+        -> flux::expected<Vec, std::string> {
+        return flux::unexpected{std::string{"fine solver failed"}};
+    }
+};
+}  // namespace
+
+TEST(PararealTest, FineSolutionAfterAllIterations) {
+    auto ex = Mesh1d{2 * pi / 64};
+    auto u0 = sin_vec(64, 0.5, 0.25);
+    auto ref = fine_slices(u0, ex, 0.5, 4);
+
+    // tol 0 never stops early, after slices iterations the result is the
+    // serial fine one, bitwise
+    auto report = PararealReport{};
+    auto solver = Parareal{coarse, fine, {.slices = 4, .tol = 0}};
+    auto res = solver.run(u0, ex, 0, 0.5, &report).value();
+    EXPECT_EQ(res.data, ref.data);
+    EXPECT_LE(report.iterations, 4);
+}
+
+TEST(PararealTest, Converges) {
+    auto ex = Mesh1d{2 * pi / 64};
+    auto u0 = sin_vec(64, 0.5, 0.25);
+    auto ref = fine_slices(u0, ex, 1.0, 8);
+
+    ThreadPool pool{4};
+    auto report = PararealReport{};
+    auto solver = Parareal{coarse, fine, {.tol = 1e-8, .pool = &pool}};
+    auto res = solver.run(u0, ex, 0, 1.0, &report).value();
+    EXPECT_LT(report.iterations, 8);
+    EXPECT_LE(report.correction, 1e-8);
+    for (size_t i = 0; i < res.size(); i++) {
+        EXPECT_NEAR(res[i], ref[i], 1e-7);
+    }
+
+    // the same on any number of threads
+    ThreadPool serial{1};
+    solver.options.pool = &serial;
+    EXPECT_EQ(solver.run(u0, ex, 0, 1.0).value().data, res.data);
+}
+
+TEST(PararealTest, FineSolverFails) {
+    auto ex = Mesh1d{0.1};
+    auto res = parareal(coarse, Failing{}, sin_vec(16, 0.5, 0.25), ex, 0, 1.0);
+    ASSERT_FALSE(res.has_value());
+    EXPECT_EQ(res.error(), "fine solver failed");
+}
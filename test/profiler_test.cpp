@@ -0,0 +1,182 @@
+#include "solver/preset.hpp"
+#include "solver/profiler.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_stdfunc.hpp"
+#include "solver/solver_virtual.hpp"
+
+#include "gtest/gtest.h"
+#include "test_problems.hpp"
+
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace flux;                 // NOLINT
+using namespace flux::profile;        // NOLINT
+using namespace flux::test_problems;  // NOLINT
+
+namespace {
+using RK3C = RK3Crtp<ode_dt, decay_L>;
+using RK3InplaceC = RK3InplaceCrtp<ode_dt, decay_L_inplace>;
+using RK3V = RK3Virtual<ode_dt, decay_L>;
+
+// upwind in tiles of 16 cells
+class TiledUpwindC
+    : public solver_crtp::TiledRK3Solver<Vec, Mesh1d, TiledUpwindC> {
+public:
+    ThreadPool *pool = nullptr;
+    TileSchedule schedule = TileSchedule::Temporal;
+
+    TileOptions tile_options() const {
+        return {.radius = 1, .cells = 16, .schedule = schedule, .pool = pool};
+    }
+
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return upwind_dt(var, ex, t);
+    }
+
+    static void op_L_tile(std::span<const double> u, std::span<double> out,
+                          const Mesh1d &ex, double t) {
+        upwind_L_tile(u, out, ex, t);
+    }
+};
+
+std::vector<std::uint64_t> call_counts(const Report &r) {
+    std::vector<std::uint64_t> result;
+    for (std::size_t i = 0; i < phase_count; ++i) {
+        result.push_back(r.phase(static_cast<Phase>(i)).calls);
+    }
+    return result;
+}
+}  // namespace
+
+TEST(ProfilerTest, PhasesAndSteps) {
+    static_assert(enabled);
+
+    auto ex = Mesh1d{0.25};
+    auto u0 = Vec{std::vector<double>{1.0, 2.0}};
+
+    report().reset();
+    RK3C{}.run(u0, ex, 0, 1.0).value();
+    const auto &r = report();
+
+    // get_dt, pre_process, op_L, post_process_rk_stage, post_process, update
+    std::vector<std::uint64_t> expected = {4, 4, 12, 12, 4, 4};
+    EXPECT_EQ(call_counts(r), expected);
+    EXPECT_EQ(r.steps(), 4);
+    EXPECT_EQ(r.dt_min(), 0.25);
+    EXPECT_EQ(r.dt_max(), 0.25);
+    EXPECT_EQ(r.dt_mean(), 0.25);
+    EXPECT_EQ(r.dt_histogram().size(), 1);
+    EXPECT_EQ(r.dt_histogram().at(-1), 4);
+
+    double callbacks = 0;
+    for (std::size_t i = 0; i < phase_count - 1; ++i) {
+        callbacks += r.phase(static_cast<Phase>(i)).seconds;
+    }
+    EXPECT_GE(r.phase(Phase::update).seconds, callbacks);
+    EXPECT_GE(r.arithmetic_seconds(), 0);
+}
+
+TEST(ProfilerTest, Allocations) {
+    auto ex = Mesh1d{0.01};
+    auto u0 = Vec{std::vector<double>{1.0, 2.0}};
+
+    // the in-place solver only allocates its stage buffers once
+    report().reset();
+    RK3InplaceC{}.run(u0, ex, 0, 0.02).value();
+    auto few_steps = report().allocations();
+
+    report().reset();
+    RK3InplaceC{}.run(u0, ex, 0, 1.0).value();
+    EXPECT_EQ(report().steps(), 100);
+    EXPECT_EQ(report().allocations(), few_steps);
+
+    // the value-based one allocates in every step
+    report().reset();
+    RK3C{}.run(u0, ex, 0, 1.0).value();
+    EXPECT_GE(report().allocations(), 100 * 3);
+}
+
+TEST(ProfilerTest, InplaceUpwindAllocationFree) {
+    using Upwind = RK3InplaceCrtp<upwind_dt, upwind_L_inplace>;
+    auto ex = Mesh1d{0.1};
+    auto u0 = sin_vec(64);
+
+    // all allocations are the stage buffers of the first step
+    report().reset();
+    Upwind{}.run(u0, ex, 0, 0.05).value();
+    EXPECT_EQ(report().steps(), 1);
+    auto first_step = report().allocations();
+
+    report().reset();
+    Upwind{}.run(u0, ex, 0, 1.0).value();
+    EXPECT_EQ(report().steps(), 20);
+    EXPECT_EQ(report().allocations(), first_step);
+}
+
+TEST(ProfilerTest, TiledAllocationFree) {
+    // a single thread, the pool tasks of a parallel step allocate
+    ThreadPool serial{1};
+    auto ex = Mesh1d{0.1};
+    auto u0 = sin_vec(64);
+
+    for (auto schedule : {TileSchedule::Temporal, TileSchedule::TaskGraph}) {
+        auto solver = TiledUpwindC{};
+        solver.pool = &serial;
+        solver.schedule = schedule;
+
+        // the stage buffers, the scratch of the tiles and the task graph,
+        // all in the first step
+        report().reset();
+        solver.run(u0, ex, 0, 0.05).value();
+        EXPECT_EQ(report().steps(), 1);
+        auto first_step = report().allocations();
+
+        report().reset();
+        solver.run(u0, ex, 0, 1.0).value();
+        EXPECT_EQ(report().steps(), 20);
+        EXPECT_EQ(report().allocations(), first_step);
+    }
+}
+
+TEST(ProfilerTest, FrameworksAgree) {
+    auto ex = Mesh1d{0.1};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    report().reset();
+    RK3C{}.run(u0, ex, 0, 1.0).value();
+    auto ref = call_counts(report());
+
+    report().reset();
+    RK3V{}.run(u0, ex, 0, 1.0).value();
+    EXPECT_EQ(call_counts(report()), ref);
+
+    using F = solver_stdfunc::UpdaterFactory<Vec, Mesh1d>;
+    auto solver_f = solver_stdfunc::Solver<Vec, Mesh1d>{};
+    solver_f.set_update(F::get_rk3_updater(decay_L, ode_dt, {}, {}, {}));
+    report().reset();
+    solver_f.run(u0, ex, 0, 1.0).value();
+    EXPECT_EQ(call_counts(report()), ref);
+}
+
+TEST(ProfilerTest, Json) {
+    auto ex = Mesh1d{0.25};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    report().reset();
+    RK3C{}.run(u0, ex, 0, 1.0).value();
+    auto json = report().to_json();
+
+    EXPECT_NE(json.find("\"enabled\": true"), std::string::npos);
+    EXPECT_NE(json.find("\"op_L\": {\"seconds\": "), std::string::npos);
+    EXPECT_NE(json.find("\"calls\": 12}"), std::string::npos);
+    EXPECT_NE(json.find("\"arithmetic\": {\"seconds\": "), std::string::npos);
+    EXPECT_NE(json.find("\"steps\": 4,"), std::string::npos);
+    EXPECT_NE(json.find("{\"decade\": -1, \"count\": 4}"), std::string::npos);
+    EXPECT_EQ(json.front(), '{');
+
+    report().reset();
+    EXPECT_EQ(report().steps(), 0);
+    EXPECT_EQ(report().dt_min(), 0);
+}
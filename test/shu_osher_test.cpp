@@ -0,0 +1,120 @@
+#include "solver/preset.hpp"
+#include "solver/shu_osher.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_stdfunc.hpp"
+#include "solver/solver_template.hpp"
+#include "solver/solver_virtual.hpp"
+
+#include "gtest/gtest.h"
+#include "test_problems.hpp"
+
+#include <cmath>
+
+using namespace flux;                 // NOLINT
+using namespace flux::test_problems;  // NOLINT
+
+namespace {
+// u' = -u^2, the exact solution at t = 1 is 0.5
+template <auto Tableau>
+class RKC : public solver_crtp::RKSolver<Vec, Mesh1d, Tableau, RKC<Tableau>> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return ode_dt(var, ex, t);
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        return quadratic_L(var, ex, t);
+    }
+};
+
+template <auto Tableau>
+class RKV : public solver_virtual::RKSolver<Vec, Mesh1d, Tableau> {
+public:
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const override {
+        return ode_dt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const override {
+        return quadratic_L(var, ex, t);
+    }
+};
+
+using RK3C = RK3Crtp<ode_dt, quadratic_L>;
+
+template <auto Tableau>
+double rk_error(double dt) {
+    auto ex = Mesh1d{dt};
+    auto u = RKC<Tableau>{}.run(Vec{std::vector<double>{1.0}}, ex, 0, 1.0);
+    return std::abs(u.value()[0] - 0.5);
+}
+
+template <auto Tableau>
+double rk_order() {
+    return std::log2(rk_error<Tableau>(0.05) / rk_error<Tableau>(0.025));
+}
+}  // namespace
+
+TEST(ShuOsherTest, StageTimes) {
+    EXPECT_DOUBLE_EQ(shu_osher::rk4.c(1), 0.5);
+    EXPECT_DOUBLE_EQ(shu_osher::rk4.c(2), 0.5);
+    EXPECT_DOUBLE_EQ(shu_osher::rk4.c(3), 1.0);
+    EXPECT_DOUBLE_EQ(shu_osher::rk4.c(4), 1.0);
+
+    EXPECT_DOUBLE_EQ(shu_osher::ssprk33.c(1), 1.0);
+    EXPECT_DOUBLE_EQ(shu_osher::ssprk33.c(2), 0.5);
+
+    // consistency, u^{n+1} is always at t + dt
+    EXPECT_NEAR(shu_osher::ssprk54.c(5), 1.0, 1e-12);
+    EXPECT_NEAR(shu_osher::ssprk104.c(10), 1.0, 1e-14);
+}
+
+TEST(ShuOsherTest, ConvergenceOrder) {
+    EXPECT_NEAR(rk_order<shu_osher::euler>(), 1.0, 0.1);
+    EXPECT_NEAR(rk_order<shu_osher::ssprk33>(), 3.0, 0.1);
+    EXPECT_NEAR(rk_order<shu_osher::ssprk54>(), 4.0, 0.15);
+    EXPECT_NEAR(rk_order<shu_osher::ssprk104>(), 4.0, 0.15);
+    EXPECT_NEAR(rk_order<shu_osher::rk4>(), 4.0, 0.1);
+}
+
+TEST(ShuOsherTest, SSPRK33MatchesRK3) {
+    auto ex = Mesh1d{0.05};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    auto ref = RK3C{}.run(u0, ex, 0, 1.0).value();
+    auto res = RKC<shu_osher::ssprk33>{}.run(u0, ex, 0, 1.0).value();
+
+    EXPECT_NEAR(res[0], ref[0], 1e-13);
+}
+
+TEST(ShuOsherTest, FrameworksAgree) {
+    auto ex = Mesh1d{0.05};
+    auto u0 = Vec{std::vector<double>{1.0}};
+
+    constexpr auto tableau = shu_osher::ssprk54;
+    auto ref = RKC<tableau>{}.run(u0, ex, 0, 1.0).value();
+
+    using N = solver_template::OpNull<Vec, Mesh1d>;
+    auto op_L = [](const Vec &var, Mesh1d &mesh, double t) {
+        return quadratic_L(var, mesh, t);
+    };
+    auto get_dt = [](const Vec &var, Mesh1d &mesh, double t) {
+        return ode_dt(var, mesh, t);
+    };
+    using U = solver_template::RKUpdater<Vec, Mesh1d, tableau, decltype(op_L),
+                                         decltype(get_dt), N, N, N>;
+    auto solver_t = solver_template::Solver<Vec, Mesh1d, U>{
+        U{op_L, get_dt, {}, {}, {}}};
+
+    using F = solver_stdfunc::UpdaterFactory<Vec, Mesh1d>;
+    auto solver_f = solver_stdfunc::Solver<Vec, Mesh1d>{};
+    solver_f.set_update(
+        F::get_rk_updater<tableau>(quadratic_L, ode_dt, {}, {}, {}));
+
+    auto results = {
+        RKV<tableau>{}.run(u0, ex, 0, 1.0).value(),
+        solver_t.run(u0, ex, 0, 1.0).value(),
+        solver_f.run(u0, ex, 0, 1.0).value(),
+    };
+
+    for (const auto &res : results) { EXPECT_EQ(res[0], ref[0]); }
+}
@@ -0,0 +1,59 @@
+#include "period_index.hpp"
+#include "simd.hpp"
+#include "weno5.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace flux;  // NOLINT
+
+namespace {
+std::vector<double> init_data(size_t n) {
+    auto u = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+        double x = static_cast<double>(i);
+        u[i] = std::sin(0.3 * x) + (i % 7 == 0 ? 1.0 : 0.0);  // with jumps
+    }
+    return u;
+}
+}  // namespace
+
+TEST(SimdTest, PackArithmetic) {
+    using P = Pack<>;
+    auto a = init_data(P::width);
+    auto b = std::vector<double>(P::width);
+    for (size_t i = 0; i < P::width; i++) { b[i] = 0.5 + a[i] * a[i]; }
+
+    auto x = P::load(a.data());
+    auto y = P::load(b.data());
+    auto res = std::vector<double>(P::width);
+    ((x + y) * 3.0 - x / y).store(res.data());
+    for (size_t i = 0; i < P::width; i++) {
+        EXPECT_EQ(res[i], (a[i] + b[i]) * 3.0 - a[i] / b[i]);
+        EXPECT_EQ(P{2.5}[i], 2.5);
+    }
+}
+
+TEST(SimdTest, Weno5SameAsScalar) {
+    // no full pack, the wrapped cells only, remainders of every size
+    auto sizes = std::vector<size_t>{0, 1, 2, 3, 4, 5, 6, 7, 9, 12, 13, 14, 15,
+                                     100, 1001};
+    for (size_t n : sizes) {
+        auto u = init_data(n);
+        auto ul = std::vector<double>{};
+        auto ur = std::vector<double>{};
+        weno5(u, ul, ur);
+
+        ASSERT_EQ(ul.size(), n);
+        ASSERT_EQ(ur.size(), n);
+        for (size_t i = 0; i < n; i++) {
+            auto idx = PeriodIndex(n, i);
+            auto faces = weno5_faces(u[idx.l(2)], u[idx.l()], u[idx.c()],
+                                     u[idx.r()], u[idx.r(2)]);
+            EXPECT_EQ(ul[i], faces.ul) << "n = " << n << ", i = " << i;
+            EXPECT_EQ(ur[i], faces.ur) << "n = " << n << ", i = " << i;
+        }
+    }
+}
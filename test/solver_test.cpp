@@ -0,0 +1,124 @@
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_stdfunc.hpp"
+#include "solver/solver_template.hpp"
+#include "solver/solver_virtual.hpp"
+
+#include "gtest/gtest.h"
+#include "test_problems.hpp"
+
+using namespace flux;                 // NOLINT
+using namespace flux::test_problems;  // NOLINT
+
+namespace {
+// u_t + u_x = 0 with periodic first order upwind
+class EulerC : public solver_crtp::EulerSolver<Vec, Mesh1d, EulerC> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return upwind_dt(var, ex, t);
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        return upwind_L(var, ex, t);
+    }
+};
+
+class EulerInplaceC
+    : public solver_crtp::EulerInplaceSolver<Vec, Mesh1d, EulerInplaceC> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return upwind_dt(var, ex, t);
+    }
+
+    static void op_L(const Vec &var, Vec &out, Mesh1d &ex, double t) {
+        upwind_L_inplace(var, out, ex, t);
+    }
+};
+
+using RK3C = RK3Crtp<upwind_dt, upwind_L>;
+using RK3InplaceC = RK3InplaceCrtp<upwind_dt, upwind_L_inplace>;
+
+class RK3InplaceV : public solver_virtual::RK3InplaceSolver<Vec, Mesh1d> {
+public:
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const override {
+        return upwind_dt(var, ex, t);
+    }
+
+    void op_L(const Vec &var, Vec &out, Mesh1d &ex,
+              double t) const override {
+        upwind_L_inplace(var, out, ex, t);
+    }
+};
+
+struct GetDtP {
+    double operator()(const Vec &var, Mesh1d &ex, double t) const {
+        return upwind_dt(var, ex, t);
+    }
+};
+
+struct OpLInplaceP {
+    void operator()(const Vec &var, Vec &out, Mesh1d &ex, double t) const {
+        upwind_L_inplace(var, out, ex, t);
+    }
+};
+}  // namespace
+
+TEST(SolverTest, EulerInplaceMatchesValue) {
+    auto ex = Mesh1d{0.1};
+    auto u0 = sin_vec(64);
+
+    auto ref = EulerC{}.run(u0, ex, 0, 1.0).value();
+    auto res = EulerInplaceC{}.run(u0, ex, 0, 1.0).value();
+
+    ASSERT_EQ(res.data.size(), ref.data.size());
+    for (size_t i = 0; i < ref.data.size(); i++) {
+        EXPECT_EQ(res.data[i], ref.data[i]);
+    }
+}
+
+TEST(SolverTest, RK3InplaceMatchesValue) {
+    auto ex = Mesh1d{0.1};
+    auto u0 = sin_vec(64);
+
+    auto ref = RK3C{}.run(u0, ex, 0, 1.0).value();
+
+    using N = solver_template::InplaceOpNull<Vec, Mesh1d>;
+    using U = solver_template::RK3InplaceUpdater<Vec, Mesh1d, OpLInplaceP,
+                                                 GetDtP, N, N, N>;
+    using F = solver_stdfunc::InplaceUpdaterFactory<Vec, Mesh1d>;
+
+    auto solver_f = solver_stdfunc::InplaceSolver<Vec, Mesh1d>{};
+    solver_f.set_update(
+        F::get_rk3_updater(upwind_L_inplace, upwind_dt, {}, {}, {}));
+
+    auto results = {
+        RK3InplaceC{}.run(u0, ex, 0, 1.0).value(),
+        RK3InplaceV{}.run(u0, ex, 0, 1.0).value(),
+        solver_template::InplaceSolver<Vec, Mesh1d, U>{}.run(u0, ex, 0, 1.0)
+            .value(),
+        solver_f.run(u0, ex, 0, 1.0).value(),
+    };
+
+    for (const auto &res : results) {
+        ASSERT_EQ(res.data.size(), ref.data.size());
+        for (size_t i = 0; i < ref.data.size(); i++) {
+            EXPECT_EQ(res.data[i], ref.data[i]);
+        }
+    }
+}
+
+TEST(SolverTest, StageBuffersReused) {
+    auto u0 = sin_vec(8);
+    StageBuffers<Vec> buffers;
+
+    auto &b0 = buffers.get(0, u0);
+    auto &b1 = buffers.get(1, u0);
+    EXPECT_EQ(buffers.size(), 2);
+    EXPECT_EQ(&buffers.get(0, u0), &b0);
+    EXPECT_EQ(&buffers.get(1, u0), &b1);
+
+    auto &b3 = buffers.get(3, u0);
+    EXPECT_EQ(buffers.size(), 4);
+    EXPECT_EQ(&buffers.get(0, u0), &b0);
+    EXPECT_EQ(b3.data, u0.data);
+}
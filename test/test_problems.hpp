@@ -0,0 +1,120 @@
+#pragma once
+
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_virtual.hpp"
+
+#include <cmath>
+#include <cstddef>
+#include <numbers>
+#include <span>
+#include <vector>
+
+// The small problems the solver tests run in every framework
+namespace flux::test_problems {
+
+// dt = ex.dx for the ODEs
+inline double ode_dt(const Vec &var, Mesh1d &ex, double t) { return ex.dx; }
+
+// u' = -u
+inline Vec decay_L(const Vec &var, Mesh1d &ex, double t) { return -1.0 * var; }
+
+inline void decay_L_inplace(const Vec &var, Vec &out, Mesh1d &ex, double t) {
+    out = -1.0 * var;
+}
+
+// u' = -u^2, u(0) = 1, exact solution u = 1 / (1 + t)
+inline Vec quadratic_L(const Vec &var, Mesh1d &ex, double t) {
+    return Vec{std::vector<double>{-var[0] * var[0]}};
+}
+
+// out = a * out + L(var), the operator of the low-storage solvers
+inline void quadratic_L_acc(const Vec &var, Vec &out, double a, Mesh1d &ex,
+                            double t) {
+    for (std::size_t i = 0; i < var.size(); i++) {
+        out[i] = (a == 0 ? 0 : a * out[i]) - var[i] * var[i];
+    }
+}
+
+// u_t + u_x = 0 with periodic first order upwind
+inline double upwind_dt(const Vec &var, Mesh1d &ex, double t) {
+    return 0.5 * ex.dx;
+}
+
+inline Vec upwind_L(const Vec &var, Mesh1d &ex, double t) {
+    const auto &u = var.data;
+    std::size_t n = u.size();
+    auto L = std::vector<double>(n);
+    for (std::size_t i = 0; i < n; i++) {
+        L[i] = -(u[i] - u[(i + n - 1) % n]) / ex.dx;
+    }
+    return Vec{L};
+}
+
+// the same as upwind_L without allocating, bitwise
+inline void upwind_L_inplace(const Vec &var, Vec &out, Mesh1d &ex, double t) {
+    std::size_t n = var.size();
+    for (std::size_t i = 0; i < n; i++) {
+        out[i] = -(var[i] - var[(i + n - 1) % n]) / ex.dx;
+    }
+}
+
+// upwind_L_inplace on a tile of radius 1, out[i] is the cell u[1 + i]
+inline void upwind_L_tile(std::span<const double> u, std::span<double> out,
+                          const Mesh1d &ex, double t) {
+    for (std::size_t i = 0; i < out.size(); i++) {
+        out[i] = -(u[i + 1] - u[i]) / ex.dx;
+    }
+}
+
+// mean + amplitude * sin(x) at the centres of n cells on [0, 2 pi]
+inline Vec sin_vec(std::size_t n, double mean = 0, double amplitude = 1) {
+    auto u = std::vector<double>(n);
+    for (std::size_t i = 0; i < n; i++) {
+        double x = 2 * std::numbers::pi * (static_cast<double>(i) + 0.5)
+                   / static_cast<double>(n);
+        u[i] = mean + amplitude * std::sin(x);
+    }
+    return Vec{u};
+}
+
+// the RK3 solvers of get_dt and op_L, e.g. RK3Crtp<upwind_dt, upwind_L>
+template <auto GetDt, auto OpL>
+class RK3Crtp
+    : public solver_crtp::RK3Solver<Vec, Mesh1d, RK3Crtp<GetDt, OpL>> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return GetDt(var, ex, t);
+    }
+
+    static Vec op_L(const Vec &var, Mesh1d &ex, double t) {
+        return OpL(var, ex, t);
+    }
+};
+
+template <auto GetDt, auto OpLInplace>
+class RK3InplaceCrtp
+    : public solver_crtp::RK3InplaceSolver<Vec, Mesh1d,
+                                           RK3InplaceCrtp<GetDt, OpLInplace>> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return GetDt(var, ex, t);
+    }
+
+    static void op_L(const Vec &var, Vec &out, Mesh1d &ex, double t) {
+        OpLInplace(var, out, ex, t);
+    }
+};
+
+template <auto GetDt, auto OpL>
+class RK3Virtual : public solver_virtual::RK3Solver<Vec, Mesh1d> {
+public:
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const override {
+        return GetDt(var, ex, t);
+    }
+
+    Vec op_L(const Vec &var, Mesh1d &ex, double t) const override {
+        return OpL(var, ex, t);
+    }
+};
+}  // namespace flux::test_problems
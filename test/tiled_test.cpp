@@ -0,0 +1,181 @@
+#include "solver/preset.hpp"
+#include "solver/solver_crtp.hpp"
+#include "solver/solver_stdfunc.hpp"
+#include "solver/solver_template.hpp"
+#include "solver/solver_virtual.hpp"
+#include "solver/tiled.hpp"
+#include "weno5.hpp"
+
+#include "gtest/gtest.h"
+#include "test_problems.hpp"
+
+#include <cmath>
+#include <span>
+#include <vector>
+
+using namespace flux;                 // NOLINT
+using namespace flux::test_problems;  // NOLINT
+
+namespace {
+// Burgers' equation, WENO5 with the Lax-Friedrichs flux
+double fhat_LF(double ul, double ur) {
+    double c = std::max(std::abs(ul), std::abs(ur));
+    return 0.5 * (ul * ul / 2 + ur * ur / 2) - 0.5 * c * (ur - ul);
+}
+
+double weno_dt(const Vec &var, Mesh1d &ex, double t) { return 0.2 * ex.dx; }
+
+void weno_L(const Vec &var, Vec &out, Mesh1d &ex, double t) {
+    size_t n = var.size();
+    auto ul = std::vector<double>(n);
+    auto ur = std::vector<double>(n);
+    weno5(var.data, ul, ur);
+    for (size_t i = 0; i < n; i++) {
+        size_t l = (i + n - 1) % n;
+        size_t r = (i + 1) % n;
+        out[i] = (fhat_LF(ur[l], ul[i]) - fhat_LF(ur[i], ul[r])) / ex.dx;
+    }
+}
+
+// u[j + 3] is the cell of out[j]
+void weno_L_tile(std::span<const double> u, std::span<double> out,
+                 const Mesh1d &ex, double t) {
+    for (size_t j = 0; j < out.size(); j++) {
+        size_t c = j + 3;
+        auto fl = weno5_faces(u[c - 3], u[c - 2], u[c - 1], u[c], u[c + 1]);
+        auto fc = weno5_faces(u[c - 2], u[c - 1], u[c], u[c + 1], u[c + 2]);
+        auto fr = weno5_faces(u[c - 1], u[c], u[c + 1], u[c + 2], u[c + 3]);
+        out[j] = (fhat_LF(fl.ur, fc.ul) - fhat_LF(fc.ur, fr.ul)) / ex.dx;
+    }
+}
+
+class Reference
+    : public solver_crtp::RK3InplaceSolver<Vec, Mesh1d, Reference> {
+public:
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return weno_dt(var, ex, t);
+    }
+
+    static void op_L(const Vec &var, Vec &out, Mesh1d &ex, double t) {
+        weno_L(var, out, ex, t);
+    }
+};
+
+class TiledC : public solver_crtp::TiledRK3Solver<Vec, Mesh1d, TiledC> {
+public:
+    explicit TiledC(size_t cells) : m_cells(cells) {}
+
+    TiledC(size_t cells, TileSchedule schedule, ThreadPool *pool)
+        : m_cells(cells), m_schedule(schedule), m_pool(pool) {}
+
+    static double get_dt(const Vec &var, Mesh1d &ex, double t) {
+        return weno_dt(var, ex, t);
+    }
+
+    static void op_L_tile(std::span<const double> u, std::span<double> out,
+                          const Mesh1d &ex, double t) {
+        weno_L_tile(u, out, ex, t);
+    }
+
+    TileOptions tile_options() const {
+        return {.cells = m_cells, .schedule = m_schedule, .pool = m_pool};
+    }
+
+private:
+    size_t m_cells;
+    TileSchedule m_schedule = TileSchedule::Temporal;
+    ThreadPool *m_pool = nullptr;
+};
+
+class TiledV : public solver_virtual::TiledRK3Solver<Vec, Mesh1d> {
+public:
+    double get_dt(const Vec &var, Mesh1d &ex, double t) const override {
+        return weno_dt(var, ex, t);
+    }
+
+    void op_L_tile(std::span<const double> u, std::span<double> out,
+                   const Mesh1d &ex, double t) const override {
+        weno_L_tile(u, out, ex, t);
+    }
+
+    TileOptions tile_options() const override { return {.cells = 16}; }
+};
+
+struct GetDtP {
+    double operator()(const Vec &var, Mesh1d &ex, double t) const {
+        return weno_dt(var, ex, t);
+    }
+};
+
+struct OpTileP {
+    void operator()(std::span<const double> u, std::span<double> out,
+                    const Mesh1d &ex, double t) const {
+        weno_L_tile(u, out, ex, t);
+    }
+};
+}  // namespace
+
+TEST(TiledTest, SameAsStageByStage) {
+    auto ex = Mesh1d{0.1};
+    auto u0 = sin_vec(101, 0.5);
+    auto ref = Reference{}.run(u0, ex, 0, 0.5).value();
+
+    // tiles dividing n or not, a single tile, tiles smaller than the halo
+    for (size_t cells : std::vector<size_t>{1, 2, 7, 50, 101, 1000}) {
+        auto res = TiledC{cells}.run(u0, ex, 0, 0.5).value();
+        EXPECT_EQ(res.data, ref.data) << cells << " cells per tile";
+    }
+
+    // three sweeps of the halo wrap around a short grid
+    auto v0 = sin_vec(5, 0.5);
+    EXPECT_EQ(TiledC{2}.run(v0, ex, 0, 0.5).value().data,
+              Reference{}.run(v0, ex, 0, 0.5).value().data);
+}
+
+TEST(TiledTest, TaskGraphSameAsStageByStage) {
+    auto ex = Mesh1d{0.1};
+    auto u0 = sin_vec(101, 0.5);
+    auto ref = Reference{}.run(u0, ex, 0, 0.5).value();
+
+    // blocks smaller than the halo, blocks without interior, one block
+    ThreadPool pool{3};
+    for (size_t cells : std::vector<size_t>{1, 5, 6, 7, 50, 101, 1000}) {
+        auto solver = TiledC{cells, TileSchedule::TaskGraph, &pool};
+        auto res = solver.run(u0, ex, 0, 0.5).value();
+        EXPECT_EQ(res.data, ref.data) << cells << " cells per block";
+    }
+
+    // a grid shorter than the halo
+    auto v0 = sin_vec(2, 0.5);
+    auto solver = TiledC{2, TileSchedule::TaskGraph, &pool};
+    EXPECT_EQ(solver.run(v0, ex, 0, 0.5).value().data,
+              Reference{}.run(v0, ex, 0, 0.5).value().data);
+}
+
+TEST(TiledTest, FrameworksAgree) {
+    auto ex = Mesh1d{0.1};
+    auto u0 = sin_vec(64, 0.5);
+    auto ref = Reference{}.run(u0, ex, 0, 0.5).value();
+
+    using N = solver_template::InplaceOpNull<Vec, Mesh1d>;
+    using U = solver_template::TiledRK3Updater<Vec, Mesh1d, OpTileP, GetDtP,
+                                               N, N>;
+    using F = solver_stdfunc::InplaceUpdaterFactory<Vec, Mesh1d>;
+
+    auto solver_f = solver_stdfunc::InplaceSolver<Vec, Mesh1d>{};
+    solver_f.set_update(
+        F::get_tiled_rk3_updater(weno_L_tile, weno_dt, {}, {},
+                                 {.cells = 10,
+                                  .schedule = TileSchedule::TaskGraph}));
+
+    auto solver_t = solver_template::InplaceSolver<Vec, Mesh1d, U>{
+        U{OpTileP{}, GetDtP{}, N{}, N{}, {.cells = 5}}};
+
+    auto results = {
+        TiledV{}.run(u0, ex, 0, 0.5).value(),
+        solver_t.run(u0, ex, 0, 0.5).value(),
+        solver_f.run(u0, ex, 0, 0.5).value(),
+    };
+
+    for (const auto &res : results) { EXPECT_EQ(res.data, ref.data); }
+}
@@ -0,0 +1,79 @@
+#include "parallel/first_touch.hpp"
+#include "solver/preset.hpp"
+
+#include "gtest/gtest.h"
+
+#include <cstdint>
+#include <vector>
+
+using namespace flux;  // NOLINT
+
+TEST(VecTest, LinearCombination) {
+    auto a = Vec{{1.0, 2.0, 3.0}};
+    auto b = Vec{{0.5, -1.0, 4.0}};
+
+    Vec c = 2.0 * a + 0.5 * (b - a);
+    ASSERT_EQ(c.size(), 3);
+    for (size_t i = 0; i < 3; i++) {
+        EXPECT_EQ(c[i], 2.0 * a[i] + 0.5 * (b[i] - a[i]));
+    }
+}
+
+TEST(VecTest, SelfReference) {
+    auto a = Vec{{1.0, 2.0, 3.0}};
+    auto b = Vec{{0.5, -1.0, 4.0}};
+    auto ref = a.data;
+
+    a = (3.0 / 4) * b + (1.0 / 4) * (a + 0.1 * b);
+    for (size_t i = 0; i < 3; i++) {
+        EXPECT_EQ(a[i], (3.0 / 4) * b[i] + (1.0 / 4) * (ref[i] + 0.1 * b[i]));
+    }
+
+    a += 2.0 * b;
+    a -= b;
+    a *= 0.5;
+    EXPECT_EQ(a.size(), 3);
+}
+
+TEST(VecTest, TemporaryOperands) {
+    auto make = [](double v) { return Vec{{v, v, v}}; };
+
+    // temporaries are moved into the expression, so it can outlive them
+    auto expr = make(1.0) + 2.0 * make(3.0);
+    Vec c = expr;
+    for (size_t i = 0; i < 3; i++) { EXPECT_EQ(c[i], 7.0); }
+}
+
+TEST(VecTest, AssignDifferentSize) {
+    auto a = Vec{{1.0}};
+    auto b = Vec{{1.0, 2.0}};
+
+    a = b + b;
+    ASSERT_EQ(a.size(), 2);
+    EXPECT_EQ(a[1], 4.0);
+}
+
+TEST(VecTest, FirstTouch) {
+    // zeroed in parallel, on a cache line
+    auto zeros = FirstTouchVec<>{FirstTouchVec<>::Storage(100000)};
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(zeros.data.data()) % 64, 0);
+    for (size_t i = 0; i < zeros.size(); i++) { ASSERT_EQ(zeros[i], 0); }
+
+    // mixes with Vec in expressions
+    auto a = FirstTouchVec<>{std::vector<double>{1.0, 2.0, 3.0}};
+    auto b = Vec{{0.5, -1.0, 4.0}};
+    FirstTouchVec<> c = 2.0 * a + b;
+    Vec d = c - a;
+    for (size_t i = 0; i < 3; i++) {
+        EXPECT_EQ(c[i], 2.0 * a[i] + b[i]);
+        EXPECT_EQ(d[i], a[i] + b[i]);
+    }
+
+    // larger than a huge page
+    size_t n = (std::size_t{4} << 20) / sizeof(double) + 3;
+    auto u = FirstTouchVec<PageSize::Huge>{std::vector<double>(n, 1.5)};
+    u *= 2.0;
+    EXPECT_EQ(reinterpret_cast<std::uintptr_t>(u.data.data()) % (2 << 20), 0);
+    EXPECT_EQ(u[0], 3.0);
+    EXPECT_EQ(u[n - 1], 3.0);
+}
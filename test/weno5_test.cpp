@@ -0,0 +1,210 @@
+#include "weno5.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <numbers>
+#include <span>
+#include <vector>
+
+using namespace flux;  // NOLINT
+
+namespace {
+std::vector<double> init_data(size_t n) {
+    auto u = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+        double x = static_cast<double>(i);
+        u[i] = std::sin(0.2 * x) + (i % 11 < 4 ? 0.5 : 0.0);  // with jumps
+    }
+    return u;
+}
+
+// largest error of the face values of the cell means of sin on [0, 2 pi]
+template <typename Policy>
+double face_error(size_t n) {
+    double dx = 2 * std::numbers::pi / static_cast<double>(n);
+    auto u = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+        double x = static_cast<double>(i) * dx;
+        u[i] = (std::cos(x) - std::cos(x + dx)) / dx;
+    }
+    auto ul = std::vector<double>{};
+    auto ur = std::vector<double>{};
+    weno5<Policy>(u, ul, ur);
+
+    double err = 0;
+    for (size_t i = 0; i < n; i++) {
+        double x = static_cast<double>(i) * dx;
+        err = std::max({err, std::abs(ul[i] - std::sin(x)),
+                        std::abs(ur[i] - std::sin(x + dx))});
+    }
+    return err;
+}
+
+// u with two periodic ghost cells on each side
+std::vector<double> pad(const std::vector<double> &u) {
+    size_t n = u.size();
+    auto padded = std::vector<double>(n + 4);
+    for (size_t j = 0; j < n + 4; j++) { padded[j] = u[(j + n - 2) % n]; }
+    return padded;
+}
+}  // namespace
+
+TEST(Weno5Test, HaloSameAsPeriodic) {
+    auto u = init_data(203);
+    auto ul = std::vector<double>{};
+    auto ur = std::vector<double>{};
+    weno5(u, ul, ur);
+
+    auto padded = pad(u);
+    auto hl = std::vector<double>(u.size());
+    auto hr = std::vector<double>(u.size());
+    weno5_halo(padded, hl, hr);
+    EXPECT_EQ(hl, ul);
+    EXPECT_EQ(hr, ur);
+
+    // block by block, blocks of any size
+    auto bl = std::vector<double>(u.size());
+    auto br = std::vector<double>(u.size());
+    auto in = std::span<const double>{padded};
+    for (size_t a = 0, m = 1; a < u.size(); a += m, m += 3) {
+        m = std::min(m, u.size() - a);
+        weno5_halo(in.subspan(a, m + 4), std::span<double>{bl}.subspan(a, m),
+                   std::span<double>{br}.subspan(a, m));
+    }
+    EXPECT_EQ(bl, ul);
+    EXPECT_EQ(br, ur);
+
+    // per block of a parallel loop, each block on the thread running it
+    auto pl = std::vector<double>(u.size());
+    auto pr = std::vector<double>(u.size());
+    size_t block = 16;
+    parallel_for(
+        0, (u.size() + block - 1) / block,
+        [&](size_t b) {
+            size_t a = b * block;
+            size_t m = std::min(block, u.size() - a);
+            auto serial = ParallelOptions{.grain = SIZE_MAX};
+            weno5_halo(in.subspan(a, m + 4),
+                       std::span<double>{pl}.subspan(a, m),
+                       std::span<double>{pr}.subspan(a, m), serial);
+        },
+        {.grain = 1});
+    EXPECT_EQ(pl, ul);
+    EXPECT_EQ(pr, ur);
+}
+
+TEST(Weno5Test, NoReallocation) {
+    auto u = init_data(100);
+    auto ul = std::vector<double>(100);
+    auto ur = std::vector<double>(100);
+    const double *ul_data = ul.data();
+    const double *ur_data = ur.data();
+    weno5(u, ul, ur);
+    EXPECT_EQ(ul.data(), ul_data);
+    EXPECT_EQ(ur.data(), ur_data);
+
+    // resized when the size differs
+    auto small = std::vector<double>{};
+    weno5(u, small, ur);
+    EXPECT_EQ(small, ul);
+}
+
+TEST(Weno5Test, OneSided) {
+    auto u = init_data(5);
+    auto faces = weno5_faces(u[0], u[1], u[2], u[3], u[4]);
+    EXPECT_EQ(weno5_left_face(u[0], u[1], u[2], u[3], u[4]), faces.ul);
+    EXPECT_EQ(weno5_right_face(u[0], u[1], u[2], u[3], u[4]), faces.ur);
+}
+
+TEST(Weno5Test, FdLfSameAsSplitWeno) {
+    const double dx = 0.1;
+    auto f = [](auto v) { return v * v / 2; };
+
+    // one block, a partial block, several blocks
+    auto sizes = std::vector<size_t>{1, 2, 3, 6, 17, 256, 257, 700};
+    for (size_t n : sizes) {
+        auto u = init_data(n);
+        double c = 0;
+        for (double v : u) { c = std::max(c, std::abs(v)); }
+
+        // both reconstructions of f+ and f-, half of them thrown away
+        auto fu_plus = std::vector<double>(n);
+        auto fu_minus = std::vector<double>(n);
+        for (size_t i = 0; i < n; i++) {
+            fu_plus[i] = 0.5 * (f(u[i]) + c * u[i]);
+            fu_minus[i] = 0.5 * (f(u[i]) - c * u[i]);
+        }
+        auto fplus_l = std::vector<double>{};
+        auto fplus_r = std::vector<double>{};
+        auto fminus_l = std::vector<double>{};
+        auto fminus_r = std::vector<double>{};
+        weno5(fu_plus, fplus_l, fplus_r);
+        weno5(fu_minus, fminus_l, fminus_r);
+        auto ref = std::vector<double>(n);
+        for (size_t i = 0; i < n; i++) {
+            size_t l = (i + n - 1) % n;
+            size_t r = (i + 1) % n;
+            double fhat_l = fplus_r[l] + fminus_l[i];
+            double fhat_r = fplus_r[i] + fminus_l[r];
+            ref[i] = (fhat_l - fhat_r) / dx;
+        }
+
+        auto L = std::vector<double>(n);
+        weno5_fd_lf(u, c, f, dx, L);
+        EXPECT_EQ(L, ref) << "n = " << n;
+    }
+}
+
+template <typename Policy>
+class Weno5PolicyTest : public ::testing::Test {};
+
+using Policies = ::testing::Types<WenoJS, WenoZ, WenoM>;
+TYPED_TEST_SUITE(Weno5PolicyTest, Policies);
+
+TYPED_TEST(Weno5PolicyTest, SameAsScalar) {
+    // the packs and the cells at the ends
+    auto u = init_data(103);
+    auto ul = std::vector<double>{};
+    auto ur = std::vector<double>{};
+    weno5<TypeParam>(u, ul, ur);
+
+    size_t n = u.size();
+    for (size_t i = 0; i < n; i++) {
+        auto idx = PeriodIndex(n, i);
+        auto faces = weno5_faces<TypeParam>(u[idx.l(2)], u[idx.l()], u[idx.c()],
+                                            u[idx.r()], u[idx.r(2)]);
+        EXPECT_EQ(ul[i], faces.ul);
+        EXPECT_EQ(ur[i], faces.ur);
+    }
+}
+
+TYPED_TEST(Weno5PolicyTest, FifthOrder) {
+    double order = std::log2(face_error<TypeParam>(80)
+                             / face_error<TypeParam>(160));
+    EXPECT_GT(order, 4.8);
+}
+
+TYPED_TEST(Weno5PolicyTest, NoOscillations) {
+    // a step, the values at the faces stay close to [0, 1]
+    auto u = std::vector<double>(40);
+    for (size_t i = 10; i < 30; i++) { u[i] = 1.0; }
+    auto ul = std::vector<double>{};
+    auto ur = std::vector<double>{};
+    weno5<TypeParam>(u, ul, ur);
+    for (size_t i = 0; i < u.size(); i++) {
+        EXPECT_GT(std::min(ul[i], ur[i]), -1e-3);
+        EXPECT_LT(std::max(ul[i], ur[i]), 1 + 1e-3);
+    }
+}
+
+TEST(Weno5Test, LessErrorThanJS) {
+    // at the extrema of sin the WENO-JS weights leave the linear ones
+    for (size_t n : std::vector<size_t>{20, 40, 80}) {
+        double js = face_error<WenoJS>(n);
+        EXPECT_LT(5 * face_error<WenoZ>(n), js) << n << " cells";
+        EXPECT_LT(5 * face_error<WenoM>(n), js) << n << " cells";
+    }
+}
@@ -0,0 +1,195 @@
+#include "weno.hpp"
+#include "weno5.hpp"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <type_traits>
+#include <vector>
+
+using namespace flux;  // NOLINT
+
+namespace {
+std::vector<double> init_data(size_t n) {
+    auto u = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+        double x = static_cast<double>(i);
+        u[i] = std::sin(0.2 * x) + (i % 11 < 4 ? 0.5 : 0.0);  // with jumps
+    }
+    return u;
+}
+
+// largest error of the face values of the cell means of sin on [0, 2 pi]
+template <size_t Order, typename Policy>
+double face_error(size_t n) {
+    double dx = 2 * std::numbers::pi / static_cast<double>(n);
+    auto u = std::vector<double>(n);
+    for (size_t i = 0; i < n; i++) {
+        double x = static_cast<double>(i) * dx;
+        u[i] = (std::cos(x) - std::cos(x + dx)) / dx;
+    }
+    auto ul = std::vector<double>{};
+    auto ur = std::vector<double>{};
+    weno<Order, Policy>(u, ul, ur);
+
+    double err = 0;
+    for (size_t i = 0; i < n; i++) {
+        double x = static_cast<double>(i) * dx;
+        err = std::max({err, std::abs(ul[i] - std::sin(x)),
+                        std::abs(ur[i] - std::sin(x + dx))});
+    }
+    return err;
+}
+}  // namespace
+
+TEST(WenoTest, Weno5Coefficients) {
+    // the literals of weno5.hpp
+    const auto &c = weno_coefficients<5>;
+    using Row = std::array<double, 3>;
+    EXPECT_EQ(c.right[0], (Row{1.0 / 3, -7.0 / 6, 11.0 / 6}));
+    EXPECT_EQ(c.right[1], (Row{-1.0 / 6, 5.0 / 6, 1.0 / 3}));
+    EXPECT_EQ(c.right[2], (Row{1.0 / 3, 5.0 / 6, -1.0 / 6}));
+    EXPECT_EQ(c.left[0], (Row{-1.0 / 6, 5.0 / 6, 1.0 / 3}));
+    EXPECT_EQ(c.left[1], (Row{1.0 / 3, 5.0 / 6, -1.0 / 6}));
+    EXPECT_EQ(c.left[2], (Row{11.0 / 6, -7.0 / 6, 1.0 / 3}));
+    EXPECT_EQ(c.d_right, (Row{1.0 / 10, 3.0 / 5, 3.0 / 10}));
+    EXPECT_EQ(c.d_left, (Row{3.0 / 10, 3.0 / 5, 1.0 / 10}));
+
+    // 13/12 (u0 - 2 u1 + u2)^2 + 1/4 (u0 - 4 u1 + 3 u2)^2 expanded
+    EXPECT_EQ(c.beta[0][0], (Row{4.0 / 3, -19.0 / 3, 11.0 / 3}));
+    EXPECT_EQ(c.beta[0][1], (Row{0, 25.0 / 3, -31.0 / 3}));
+    EXPECT_EQ(c.beta[0][2], (Row{0, 0, 10.0 / 3}));
+}
+
+TEST(WenoTest, Weno7Coefficients) {
+    // Balsara, Shu 2000
+    const auto &c = weno_coefficients<7>;
+    using Row = std::array<double, 4>;
+    EXPECT_EQ(c.d_right, (Row{1.0 / 35, 12.0 / 35, 18.0 / 35, 4.0 / 35}));
+    EXPECT_EQ(c.right[0],
+              (Row{-1.0 / 4, 13.0 / 12, -23.0 / 12, 25.0 / 12}));
+    EXPECT_EQ(c.beta[0][0],
+              (Row{547.0 / 240, -3882.0 / 240, 4642.0 / 240, -1854.0 / 240}));
+}
+
+TEST(WenoTest, Weno5UpToRounding) {
+    auto u = init_data(103);
+    auto ul = std::vector<double>{};
+    auto ur = std::vector<double>{};
+    weno5(u, ul, ur);
+    auto gl = std::vector<double>{};
+    auto gr = std::vector<double>{};
+    weno<5>(u, gl, gr);
+    for (size_t i = 0; i < u.size(); i++) {
+        EXPECT_NEAR(gl[i], ul[i], 1e-14);
+        EXPECT_NEAR(gr[i], ur[i], 1e-14);
+    }
+}
+
+TEST(WenoTest, DesignOrder) {
+    // the mapped weights keep the order at the extrema of sin, WENO-JS does
+    // not from WENO7 on
+    auto order = [](double coarse, double fine) {
+        return std::log2(coarse / fine);
+    };
+    EXPECT_GT(order(face_error<5, WenoM>(20), face_error<5, WenoM>(40)), 4.8);
+    EXPECT_GT(order(face_error<7, WenoM>(20), face_error<7, WenoM>(40)), 6.8);
+    EXPECT_GT(order(face_error<9, WenoM>(20), face_error<9, WenoM>(40)), 8.8);
+
+    // fewer cells for the same error
+    double err5 = face_error<5, WenoJS>(80);
+    double err7 = face_error<7, WenoJS>(40);
+    EXPECT_LT(err7, err5);
+    double err9 = face_error<9, WenoJS>(40);
+    err7 = face_error<7, WenoJS>(80);
+    EXPECT_LT(err9, err7);
+}
+
+template <typename Order>
+class WenoOrderTest : public ::testing::Test {};
+
+using Orders =
+    ::testing::Types<std::integral_constant<size_t, 3>,
+                     std::integral_constant<size_t, 5>,
+                     std::integral_constant<size_t, 7>,
+                     std::integral_constant<size_t, 9>>;
+TYPED_TEST_SUITE(WenoOrderTest, Orders);
+
+TYPED_TEST(WenoOrderTest, SameAsScalar) {
+    constexpr size_t order = TypeParam::value;
+
+    // the packs, the cells at the ends, and fewer cells than the stencil
+    for (size_t n : std::vector<size_t>{1, 2, 5, 103}) {
+        auto u = init_data(n);
+        auto ul = std::vector<double>{};
+        auto ur = std::vector<double>{};
+        weno<order>(u, ul, ur);
+
+        for (size_t i = 0; i < n; i++) {
+            auto v = std::array<double, order>{};
+            for (size_t j = 0; j < order; j++) {
+                v[j] = u[(i + j + order * n - order / 2) % n];
+            }
+            auto faces = weno_faces<order>(v);
+            EXPECT_EQ(ul[i], faces.ul) << n << " cells";
+            EXPECT_EQ(ur[i], faces.ur) << n << " cells";
+            EXPECT_EQ(weno_left_face<order>(v), faces.ul);
+            EXPECT_EQ(weno_right_face<order>(v), faces.ur);
+        }
+    }
+}
+
+TYPED_TEST(WenoOrderTest, NoOscillations) {
+    constexpr size_t order = TypeParam::value;
+
+    // a step, the values at the faces stay close to [0, 1]
+    auto u = std::vector<double>(40);
+    for (size_t i = 10; i < 30; i++) { u[i] = 1.0; }
+    auto ul = std::vector<double>{};
+    auto ur = std::vector<double>{};
+    weno<order>(u, ul, ur);
+    for (size_t i = 0; i < u.size(); i++) {
+        EXPECT_GT(std::min(ul[i], ur[i]), -1e-3);
+        EXPECT_LT(std::max(ul[i], ur[i]), 1 + 1e-3);
+    }
+}
+
+TYPED_TEST(WenoOrderTest, FdLfSameAsSplitWeno) {
+    constexpr size_t order = TypeParam::value;
+    const double dx = 0.1;
+    auto f = [](auto v) { return v * v / 2; };
+
+    auto sizes = std::vector<size_t>{1, 2, 3, 6, 17, 256, 257, 700};
+    for (size_t n : sizes) {
+        auto u = init_data(n);
+        double c = 0;
+        for (double v : u) { c = std::max(c, std::abs(v)); }
+
+        auto fu_plus = std::vector<double>(n);
+        auto fu_minus = std::vector<double>(n);
+        for (size_t i = 0; i < n; i++) {
+            fu_plus[i] = 0.5 * (f(u[i]) + c * u[i]);
+            fu_minus[i] = 0.5 * (f(u[i]) - c * u[i]);
+        }
+        auto fplus_l = std::vector<double>{};
+        auto fplus_r = std::vector<double>{};
+        auto fminus_l = std::vector<double>{};
+        auto fminus_r = std::vector<double>{};
+        weno<order>(fu_plus, fplus_l, fplus_r);
+        weno<order>(fu_minus, fminus_l, fminus_r);
+        auto ref = std::vector<double>(n);
+        for (size_t i = 0; i < n; i++) {
+            size_t l = (i + n - 1) % n;
+            size_t r = (i + 1) % n;
+            double fhat_l = fplus_r[l] + fminus_l[i];
+            double fhat_r = fplus_r[i] + fminus_l[r];
+            ref[i] = (fhat_l - fhat_r) / dx;
+        }
+
+        auto L = std::vector<double>(n);
+        weno_fd_lf<order>(u, c, f, dx, L);
+        EXPECT_EQ(L, ref) << "n = " << n;
+    }
+}